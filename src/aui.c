@@ -10,781 +10,4516 @@
 #include "aui.h"
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 #include <signal.h>
+#ifdef AUI_THREADS
+#include <pthread.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && (AUI_TYPE_MAX <= UINT_MAX)
+#define BUILTIN_MSBN(native) (sizeof(unsigned int) * CHAR_BIT - 1 - __builtin_clz(native))
+#define BUILTIN_LSBN(native) __builtin_ctz(native)
+#define BUILTIN_POPCOUNT(native) __builtin_popcount(native)
+#elif defined(__GNUC__) && (AUI_TYPE_MAX <= ULONG_MAX)
+#define BUILTIN_MSBN(native) (sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl(native))
+#define BUILTIN_LSBN(native) __builtin_ctzl(native)
+#define BUILTIN_POPCOUNT(native) __builtin_popcountl(native)
+#elif defined(__GNUC__) && defined(ULLONG_MAX) && (AUI_TYPE_MAX <= ULLONG_MAX)
+#define BUILTIN_MSBN(native) (sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(native))
+#define BUILTIN_LSBN(native) __builtin_ctzll(native)
+#define BUILTIN_POPCOUNT(native) __builtin_popcountll(native)
+#elif (AUI_TYPE_BIT == 8)
+#define DEBRUIJN 0x1D
+#define SHIFT 5
+static const unsigned char most[AUI_TYPE_BIT] = {
+	0, 5, 1, 6, 4, 3, 2, 7
+};
+static const unsigned char least[AUI_TYPE_BIT] = {
+	0, 1, 6, 2, 7, 5, 4, 3
+};
+#elif (AUI_TYPE_BIT == 16)
+#define DEBRUIJN 0x0F65
+#define SHIFT 12
+static const unsigned char most[AUI_TYPE_BIT] = {
+	0, 10, 1, 13, 11, 7, 2, 14, 9, 12, 6, 8, 5, 4, 3, 15
+};
+static const unsigned char least[AUI_TYPE_BIT] = {
+	0, 1, 11, 2, 14, 12, 8, 3, 15, 10, 13, 7, 9, 6, 5, 4
+};
+#elif (AUI_TYPE_BIT == 32)
+#define DEBRUIJN 0x07DCD629UL
+#define SHIFT 27
+static const unsigned char most[AUI_TYPE_BIT] = {
+	0, 22, 1, 28, 23, 13, 2, 29, 26, 24, 17, 19, 14, 9, 3, 30,
+	21, 27, 12, 25, 16, 18, 8, 20, 11, 15, 7, 10, 6, 5, 4, 31
+};
+static const unsigned char least[AUI_TYPE_BIT] = {
+	0, 1, 23, 2, 29, 24, 14, 3, 30, 27, 25, 18, 20, 15, 10, 4,
+	31, 22, 28, 13, 26, 17, 19, 9, 21, 12, 16, 8, 11, 7, 6, 5
+};
+#elif (AUI_TYPE_BIT == 64)
+#define DEBRUIJN (((AUI_TYPE)0x03F79D71UL << 32) | 0xB4CB0A89UL)
+#define SHIFT 58
+static const unsigned char most[AUI_TYPE_BIT] = {
+	0, 47, 1, 56, 48, 27, 2, 60, 57, 49, 41, 37, 28, 16, 3, 61,
+	54, 58, 35, 52, 50, 42, 21, 44, 38, 32, 29, 23, 17, 11, 4, 62,
+	46, 55, 26, 59, 40, 36, 15, 53, 34, 51, 20, 43, 31, 22, 10, 45,
+	25, 39, 14, 33, 19, 30, 9, 24, 13, 18, 8, 12, 7, 6, 5, 63
+};
+static const unsigned char least[AUI_TYPE_BIT] = {
+	0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+	62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+	63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+	46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+};
+#else
+#error "AUI_TYPE_BIT must be 8, 16, 32 or 64"
+#endif
+
+/* compile-time checks of the AUI_TYPE definitions in aui.h */
+typedef char check_type_bit[(AUI_TYPE_BIT == (sizeof(AUI_TYPE) * CHAR_BIT)) ? 1 : -1];
+typedef char check_type_max[(AUI_TYPE_MAX == ((AUI_TYPE)-1)) ? 1 : -1];
 
-static AUI_TYPE shift;
-static AUI_TYPE debruijn;
-static AUI_TYPE most[AUI_TYPE_BIT];
-static AUI_TYPE least[AUI_TYPE_BIT];
 static struct aui *list = NULL;
 
-static int chartoint(char character, const char *set, int base)
+#ifdef AUI_THREADS
+/* the number of threads aui_mul(), aui_gets() and aui_sets() may use */
+static unsigned int threads = 1;
+
+/* the least length of both operands of a multiplication using threads */
+#ifndef AUI_THREADS_THRESHOLD
+#define AUI_THREADS_THRESHOLD AUI_SIZTOLEN(4096)
+#endif
+#endif
+
+#if (AUI_TYPE_BIT <= 16) || ((AUI_TYPE_BIT == 32) && (ULONG_MAX > 0xFFFFFFFFUL))
+typedef unsigned long wide;
+#define WIDE
+#elif defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 wide;
+#define WIDE
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_X86
+#if defined(__x86_64__) && (AUI_TYPE_BIT == 64)
+#define CPU_X86_64
+#endif
+#define CPU_ADX 0x01
+#define CPU_BMI2 0x02
+#define CPU_AVX2 0x04
+#define CPU_AVX512F 0x08
+#define CPU_AVX512VBMI2 0x10
+#define CPU_AVX512BW 0x20
+#define CPU_POPCNT 0x40
+#define CPU_AVX512VPOPCNTDQ 0x80
+
+static unsigned int cpu(void)
 {
-	assert(set);
-	assert(base >= 2);
-	assert(base <= CHAR_MAX);
-	while (base--)
-		if (set[base] == character)
-			return base;
-	return base;
+	static unsigned int features = 0;
+	static int detected = 0;
+	unsigned int a;
+	unsigned int b;
+	unsigned int c;
+	unsigned int d;
+	unsigned int xcr0;
+	unsigned int ignore;
+
+	if (detected)
+		return features;
+	xcr0 = 0;
+	if (__get_cpuid(1, &a, &b, &c, &d)) {
+		if (c & bit_POPCNT)
+			features |= CPU_POPCNT;
+		if (c & bit_OSXSAVE)
+			__asm__ ("xgetbv" : "=a" (xcr0), "=d" (ignore) : "c" (0));
+	}
+	if (__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+		if (b & bit_ADX)
+			features |= CPU_ADX;
+		if (b & bit_BMI2)
+			features |= CPU_BMI2;
+		/* the vector registers must also be saved by the operating system */
+		if ((b & bit_AVX2) && ((xcr0 & 0x06) == 0x06))
+			features |= CPU_AVX2;
+		if ((b & bit_AVX512F) && ((xcr0 & 0xE6) == 0xE6))
+			features |= CPU_AVX512F;
+		if ((c & bit_AVX512VBMI2) && ((xcr0 & 0xE6) == 0xE6))
+			features |= CPU_AVX512VBMI2;
+		if ((b & bit_AVX512BW) && ((xcr0 & 0xE6) == 0xE6))
+			features |= CPU_AVX512BW;
+		if ((c & bit_AVX512VPOPCNTDQ) && ((xcr0 & 0xE6) == 0xE6))
+			features |= CPU_AVX512VPOPCNTDQ;
+	}
+	detected = 1;
+	return features;
 }
+#endif
 
-void aui_init(void)
+#ifdef __GNUC__
+#define PREFETCH(address, write) __builtin_prefetch((address), (write))
+#else
+#define PREFETCH(address, write) ((void)0)
+#endif
+
+/* x * y as a double limb; returns the low limb and stores the high limb in *hi */
+static AUI_TYPE mul_ll(AUI_TYPE *hi, AUI_TYPE x, AUI_TYPE y)
 {
-	unsigned int i;
+#ifdef WIDE
+	wide product;
+
+	product = (wide)x * y;
+	*hi = product >> AUI_TYPE_BIT;
+	return product;
+#else
 	AUI_TYPE mask;
+	AUI_TYPE ll;
+	AUI_TYPE lh;
+	AUI_TYPE hl;
+	AUI_TYPE middle;
 
-	assert(AUI_TYPE_BIT == (sizeof(AUI_TYPE) * CHAR_BIT));
-	assert(AUI_TYPE_MAX == ((AUI_TYPE)-1));
-	shift = 0;
-	i = AUI_TYPE_BIT;
-	while (i >>= 1)
-		shift++;
-	assert(AUI_TYPE_BIT == (1 << shift));
-	shift = AUI_TYPE_BIT - shift;
-	debruijn = 0;
-	i = AUI_TYPE_BIT;
-	while (i--)
-		most[i] = !i;
-	mask = AUI_TYPE_MAX >> shift;
-	i = shift;
+	mask = AUI_TYPE_MAX >> (AUI_TYPE_BIT / 2);
+	ll = (x & mask) * (y & mask);
+	lh = (x & mask) * (y >> (AUI_TYPE_BIT / 2));
+	hl = (x >> (AUI_TYPE_BIT / 2)) * (y & mask);
+	middle = (ll >> (AUI_TYPE_BIT / 2)) + (lh & mask) + (hl & mask);
+	*hi = (x >> (AUI_TYPE_BIT / 2)) * (y >> (AUI_TYPE_BIT / 2))
+		+ (lh >> (AUI_TYPE_BIT / 2)) + (hl >> (AUI_TYPE_BIT / 2))
+		+ (middle >> (AUI_TYPE_BIT / 2));
+	return (middle << (AUI_TYPE_BIT / 2)) | (ll & mask);
+#endif
+}
+
+/*
+ * Limb-level kernels operating on n limbs, least significant limb first;
+ * r may be identical to x or y. Each returns the carry (or borrow) out of
+ * the most significant limb.
+ */
+
+/* r = x + carry */
+static AUI_TYPE add_1(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE carry)
+{
+	size_t i;
+
+	i = 0;
+	while (carry && (i < n)) {
+		r[i] = x[i] + carry;
+		carry = (r[i] < carry);
+		i++;
+	}
+	if (r != x)
+		while (i < n) {
+			r[i] = x[i];
+			i++;
+		}
+	return carry;
+}
+
+/* r = x - borrow */
+static AUI_TYPE sub_1(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE borrow)
+{
+	AUI_TYPE binary;
+	size_t i;
+
+	i = 0;
+	while (borrow && (i < n)) {
+		binary = x[i];
+		r[i] = binary - borrow;
+		borrow = (binary < borrow);
+		i++;
+	}
+	if (r != x)
+		while (i < n) {
+			r[i] = x[i];
+			i++;
+		}
+	return borrow;
+}
+
+/* r = x + y + carry, carry 0 or 1 */
+static AUI_TYPE add_n(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t n, AUI_TYPE carry)
+{
+#ifdef CPU_X86_64
+	AUI_TYPE count;
+	AUI_TYPE binary;
+
+	if (!n)
+		return carry;
+	count = n;
+	__asm__ __volatile__ (
+		"negq %[carry]\n\t"
+		"1:\n\t"
+		"movq (%[x]), %[binary]\n\t"
+		"adcq (%[y]), %[binary]\n\t"
+		"movq %[binary], (%[r])\n\t"
+		"leaq 8(%[x]), %[x]\n\t"
+		"leaq 8(%[y]), %[y]\n\t"
+		"leaq 8(%[r]), %[r]\n\t"
+		"decq %[count]\n\t"
+		"jnz 1b\n\t"
+		"movl $0, %k[carry]\n\t"
+		"adcl $0, %k[carry]\n\t"
+		: [r] "+r" (r), [x] "+r" (x), [y] "+r" (y), [count] "+r" (count),
+		  [carry] "+r" (carry), [binary] "=&r" (binary)
+		:
+		: "cc", "memory");
+	return carry;
+#else
+	AUI_TYPE sum;
+	size_t i;
+
+	i = 0;
+	while (i < n) {
+		sum = x[i] + carry;
+		carry = (sum < carry);
+		r[i] = sum + y[i];
+		carry += (r[i] < sum);
+		i++;
+	}
+	return carry;
+#endif
+}
+
+/* r = x - y - borrow, borrow 0 or 1 */
+static AUI_TYPE sub_n(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t n, AUI_TYPE borrow)
+{
+#ifdef CPU_X86_64
+	AUI_TYPE count;
+	AUI_TYPE binary;
+
+	if (!n)
+		return borrow;
+	count = n;
+	__asm__ __volatile__ (
+		"negq %[borrow]\n\t"
+		"1:\n\t"
+		"movq (%[x]), %[binary]\n\t"
+		"sbbq (%[y]), %[binary]\n\t"
+		"movq %[binary], (%[r])\n\t"
+		"leaq 8(%[x]), %[x]\n\t"
+		"leaq 8(%[y]), %[y]\n\t"
+		"leaq 8(%[r]), %[r]\n\t"
+		"decq %[count]\n\t"
+		"jnz 1b\n\t"
+		"movl $0, %k[borrow]\n\t"
+		"adcl $0, %k[borrow]\n\t"
+		: [r] "+r" (r), [x] "+r" (x), [y] "+r" (y), [count] "+r" (count),
+		  [borrow] "+r" (borrow), [binary] "=&r" (binary)
+		:
+		: "cc", "memory");
+	return borrow;
+#else
+	AUI_TYPE binary;
+	AUI_TYPE difference;
+	size_t i;
+
+	i = 0;
+	while (i < n) {
+		binary = x[i];
+		difference = binary - y[i];
+		r[i] = difference - borrow;
+		borrow = (difference > binary) | (difference < borrow);
+		i++;
+	}
+	return borrow;
+#endif
+}
+
+/* r = x * y + carry */
+static AUI_TYPE mul_1_c(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y, AUI_TYPE carry)
+{
+	AUI_TYPE hi;
+	AUI_TYPE lo;
+	size_t i;
+
+	i = 0;
+	while (i < n) {
+		lo = mul_ll(&hi, x[i], y);
+		lo += carry;
+		hi += (lo < carry);
+		r[i] = lo;
+		carry = hi;
+		i++;
+	}
+	return carry;
+}
+
+/* r = r + x * y */
+static AUI_TYPE addmul_1_c(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y)
+{
+	AUI_TYPE carry;
+	AUI_TYPE hi;
+	AUI_TYPE lo;
+	size_t i;
+
+	carry = 0;
+	i = 0;
+	while (i < n) {
+		lo = mul_ll(&hi, x[i], y);
+		lo += carry;
+		hi += (lo < carry);
+		r[i] += lo;
+		carry = hi + (r[i] < lo);
+		i++;
+	}
+	return carry;
+}
+
+#ifdef CPU_X86_64
+/* MULX leaves the flags alone, so the carry chain may run through ADCX */
+__attribute__((target("bmi2,adx")))
+static AUI_TYPE mul_1_adx(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y, AUI_TYPE carry)
+{
+	AUI_TYPE count;
+	AUI_TYPE remainder;
+	AUI_TYPE hi;
+	AUI_TYPE lo;
+
+	count = n >> 2;
+	remainder = n & 3;
+	__asm__ __volatile__ (
+		"xorl %k[lo], %k[lo]\n\t"
+		"1:\n\t"
+		"jrcxz 2f\n\t"
+		"mulxq (%[x]), %[lo], %[hi]\n\t"
+		"adcxq %[carry], %[lo]\n\t"
+		"movq %[lo], (%[r])\n\t"
+		"mulxq 8(%[x]), %[lo], %[carry]\n\t"
+		"adcxq %[hi], %[lo]\n\t"
+		"movq %[lo], 8(%[r])\n\t"
+		"mulxq 16(%[x]), %[lo], %[hi]\n\t"
+		"adcxq %[carry], %[lo]\n\t"
+		"movq %[lo], 16(%[r])\n\t"
+		"mulxq 24(%[x]), %[lo], %[carry]\n\t"
+		"adcxq %[hi], %[lo]\n\t"
+		"movq %[lo], 24(%[r])\n\t"
+		"leaq 32(%[x]), %[x]\n\t"
+		"leaq 32(%[r]), %[r]\n\t"
+		"leaq -1(%%rcx), %%rcx\n\t"
+		"jmp 1b\n\t"
+		"2:\n\t"
+		"movq %[remainder], %%rcx\n\t"
+		"3:\n\t"
+		"jrcxz 4f\n\t"
+		"mulxq (%[x]), %[lo], %[hi]\n\t"
+		"adcxq %[carry], %[lo]\n\t"
+		"movq %[lo], (%[r])\n\t"
+		"movq %[hi], %[carry]\n\t"
+		"leaq 8(%[x]), %[x]\n\t"
+		"leaq 8(%[r]), %[r]\n\t"
+		"leaq -1(%%rcx), %%rcx\n\t"
+		"jmp 3b\n\t"
+		"4:\n\t"
+		"movl $0, %k[lo]\n\t"
+		"adcxq %[lo], %[carry]\n\t"
+		: [r] "+r" (r), [x] "+r" (x), "+c" (count), [carry] "+r" (carry),
+		  [hi] "=&r" (hi), [lo] "=&r" (lo)
+		: "d" (y), [remainder] "r" (remainder)
+		: "cc", "memory");
+	return carry;
+}
+
+/*
+ * Two independent carry chains: ADOX adds the high limb of the previous
+ * product (overflow flag), ADCX adds the limb of r (carry flag).
+ */
+__attribute__((target("bmi2,adx")))
+static AUI_TYPE addmul_1_adx(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y)
+{
+	AUI_TYPE count;
+	AUI_TYPE remainder;
+	AUI_TYPE carry;
+	AUI_TYPE hi;
+	AUI_TYPE lo;
+
+	count = n >> 2;
+	remainder = n & 3;
+	carry = 0;
+	__asm__ __volatile__ (
+		"xorl %k[lo], %k[lo]\n\t"
+		"1:\n\t"
+		"jrcxz 2f\n\t"
+		"mulxq (%[x]), %[lo], %[hi]\n\t"
+		"adoxq %[carry], %[lo]\n\t"
+		"adcxq (%[r]), %[lo]\n\t"
+		"movq %[lo], (%[r])\n\t"
+		"mulxq 8(%[x]), %[lo], %[carry]\n\t"
+		"adoxq %[hi], %[lo]\n\t"
+		"adcxq 8(%[r]), %[lo]\n\t"
+		"movq %[lo], 8(%[r])\n\t"
+		"mulxq 16(%[x]), %[lo], %[hi]\n\t"
+		"adoxq %[carry], %[lo]\n\t"
+		"adcxq 16(%[r]), %[lo]\n\t"
+		"movq %[lo], 16(%[r])\n\t"
+		"mulxq 24(%[x]), %[lo], %[carry]\n\t"
+		"adoxq %[hi], %[lo]\n\t"
+		"adcxq 24(%[r]), %[lo]\n\t"
+		"movq %[lo], 24(%[r])\n\t"
+		"leaq 32(%[x]), %[x]\n\t"
+		"leaq 32(%[r]), %[r]\n\t"
+		"leaq -1(%%rcx), %%rcx\n\t"
+		"jmp 1b\n\t"
+		"2:\n\t"
+		"movq %[remainder], %%rcx\n\t"
+		"3:\n\t"
+		"jrcxz 4f\n\t"
+		"mulxq (%[x]), %[lo], %[hi]\n\t"
+		"adoxq %[carry], %[lo]\n\t"
+		"adcxq (%[r]), %[lo]\n\t"
+		"movq %[lo], (%[r])\n\t"
+		"movq %[hi], %[carry]\n\t"
+		"leaq 8(%[x]), %[x]\n\t"
+		"leaq 8(%[r]), %[r]\n\t"
+		"leaq -1(%%rcx), %%rcx\n\t"
+		"jmp 3b\n\t"
+		"4:\n\t"
+		"movl $0, %k[lo]\n\t"
+		"adoxq %[lo], %[carry]\n\t"
+		"adcxq %[lo], %[carry]\n\t"
+		: [r] "+r" (r), [x] "+r" (x), "+c" (count), [carry] "+r" (carry),
+		  [hi] "=&r" (hi), [lo] "=&r" (lo)
+		: "d" (y), [remainder] "r" (remainder)
+		: "cc", "memory");
+	return carry;
+}
+
+static AUI_TYPE mul_1_init(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y, AUI_TYPE carry);
+static AUI_TYPE addmul_1_init(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y);
+
+static AUI_TYPE (*mul_1)(AUI_TYPE *, const AUI_TYPE *, size_t, AUI_TYPE, AUI_TYPE) = mul_1_init;
+static AUI_TYPE (*addmul_1)(AUI_TYPE *, const AUI_TYPE *, size_t, AUI_TYPE) = addmul_1_init;
+
+/* select the kernels on first use, the selection is the same for all threads */
+static AUI_TYPE mul_1_init(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y, AUI_TYPE carry)
+{
+	mul_1 = ((cpu() & (CPU_ADX | CPU_BMI2)) == (CPU_ADX | CPU_BMI2)) ? mul_1_adx : mul_1_c;
+	return mul_1(r, x, n, y, carry);
+}
+
+static AUI_TYPE addmul_1_init(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y)
+{
+	addmul_1 = ((cpu() & (CPU_ADX | CPU_BMI2)) == (CPU_ADX | CPU_BMI2)) ? addmul_1_adx : addmul_1_c;
+	return addmul_1(r, x, n, y);
+}
+#else
+#define mul_1 mul_1_c
+#define addmul_1 addmul_1_c
+#endif
+
+/* r = r - x * y */
+static AUI_TYPE submul_1(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE y)
+{
+	AUI_TYPE borrow;
+	AUI_TYPE hi;
+	AUI_TYPE lo;
+	size_t i;
+
+	borrow = 0;
+	i = 0;
+	while (i < n) {
+		lo = mul_ll(&hi, x[i], y);
+		lo += borrow;
+		hi += (lo < borrow);
+		borrow = hi + (r[i] < lo);
+		r[i] -= lo;
+		i++;
+	}
+	return borrow;
+}
+
+/* r = x * y, truncated to n limbs; r must not overlap x or y */
+static void mul(AUI_TYPE *r, const AUI_TYPE *x, size_t n, const AUI_TYPE *y, size_t m)
+{
+	size_t length;
+	size_t i;
+	size_t j;
+	AUI_TYPE carry;
+
+	memset(r, 0, sizeof(*r) * n);
+	length = n;
+	while (length && !x[length - 1])
+		length--;
+	i = (n < m) ? n : m;
 	while (i--) {
-		debruijn = (debruijn << 1) | 1;
-		if (most[debruijn & mask])
-			debruijn ^= 1;
-		most[debruijn & mask] = 1;
+		if (!y[i])
+			continue;
+		j = ((n - i) < length) ? (n - i) : length;
+		carry = addmul_1(r + i, x, j, y[i]);
+		add_1(r + i + j, r + i + j, n - i - j, carry);
+	}
+	return;
+}
+
+#ifdef AUI_THREADS
+/* runs function on count jobs, count - 1 of them on new threads */
+static void parallel(void *(*function)(void *), void *jobs, size_t size, size_t count)
+{
+	pthread_t thread[64];
+	int created[64];
+	size_t i;
+
+	assert(count <= 64);
+	i = 1;
+	while (i < count) {
+		created[i] = !pthread_create(&thread[i], NULL, function, (char *)jobs + size * i);
+		if (!created[i])
+			function((char *)jobs + size * i);
+		i++;
 	}
-	i = AUI_TYPE_BIT;
+	function(jobs);
+	while (--i)
+		if (created[i])
+			pthread_join(thread[i], NULL);
+	return;
+}
+
+struct job {
+	AUI_TYPE *r;
+	const AUI_TYPE *x;
+	size_t n;
+	const AUI_TYPE *y;
+	size_t m;
+};
+
+static void *mul_job(void *argument)
+{
+	struct job *job;
+
+	job = argument;
+	mul(job->r, job->x, job->n, job->y, job->m);
+	return NULL;
+}
+
+/*
+ * r = x * y, truncated to n limbs, with the rows of y split between count
+ * threads so that each gets about the same number of limb products; the
+ * partial products are summed into r afterwards.
+ */
+static int mul_threads(AUI_TYPE *r, const AUI_TYPE *x, size_t n, const AUI_TYPE *y, size_t m, unsigned int count)
+{
+	struct job job[64];
+	AUI_TYPE *buffer;
+	size_t length;
+	size_t total;
+	size_t work;
+	size_t size;
+	size_t i;
+	size_t j;
+
+	length = n;
+	while (length && !x[length - 1])
+		length--;
+	m = (n < m) ? n : m;
+	while (m && !y[m - 1])
+		m--;
+	total = 0;
+	i = 0;
+	while (i < m) {
+		total += ((n - i) < length) ? (n - i) : length;
+		i++;
+	}
+	count = (count < 64) ? count : 64;
+	count = (count < m) ? count : m;
+	if (count < 2)
+		return 0;
+	work = total / count + 1;
+	size = 0;
+	total = 0;
+	i = 0;
+	j = 0;
+	while (j < count) {
+		job[j].x = x;
+		job[j].n = n - i;
+		job[j].y = y + i;
+		while ((i < m) && (total < work * (j + 1))) {
+			total += ((n - i) < length) ? (n - i) : length;
+			i++;
+		}
+		job[j].m = y + i - job[j].y;
+		size += j ? job[j].n : 0;
+		j++;
+	}
+	if (!(buffer = malloc(sizeof(*buffer) * size)))
+		return 0;
+	job[0].r = r;
+	size = 0;
+	j = 1;
+	while (j < count) {
+		job[j].r = buffer + size;
+		size += job[j].n;
+		j++;
+	}
+	/* resolve the dispatched kernels before the threads use them */
+	addmul_1(r, x, 0, 0);
+	parallel(mul_job, job, sizeof(*job), count);
+	j = 1;
+	while (j < count) {
+		add_n(r + (n - job[j].n), r + (n - job[j].n), job[j].r, job[j].n, 0);
+		j++;
+	}
+	free(buffer);
+	return 1;
+}
+#endif
+
+/* bitwise kernels: r = x op y over n limbs (y is ignored for ONE); r may be x or y */
+#define AND 0
+#define IOR 1
+#define XOR 2
+#define ONE 3
+
+static void bitwise_c(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t n, int op)
+{
+	switch (op) {
+	case AND:
+		while (n--)
+			r[n] = x[n] & y[n];
+		break;
+	case IOR:
+		while (n--)
+			r[n] = x[n] | y[n];
+		break;
+	case XOR:
+		while (n--)
+			r[n] = x[n] ^ y[n];
+		break;
+	default:
+		while (n--)
+			r[n] = ~x[n];
+		break;
+	}
+	return;
+}
+
+#ifdef CPU_X86
+__attribute__((target("avx2")))
+static void bitwise_avx2(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t n, int op)
+{
+	size_t size;
+	size_t i;
+	__m256i a;
+	__m256i b;
+
+	size = n * sizeof(*x);
+	b = _mm256_set1_epi8(-1);
+	i = 0;
+	while ((i + 32) <= size) {
+		a = _mm256_loadu_si256((const __m256i *)((const unsigned char *)x + i));
+		if (op != ONE)
+			b = _mm256_loadu_si256((const __m256i *)((const unsigned char *)y + i));
+		switch (op) {
+		case AND:
+			a = _mm256_and_si256(a, b);
+			break;
+		case IOR:
+			a = _mm256_or_si256(a, b);
+			break;
+		default:
+			a = _mm256_xor_si256(a, b);
+			break;
+		}
+		_mm256_storeu_si256((__m256i *)((unsigned char *)r + i), a);
+		i += 32;
+	}
+	i /= sizeof(*x);
+	bitwise_c(r + i, x + i, y + i, n - i, op);
+	return;
+}
+
+__attribute__((target("avx512f")))
+static void bitwise_avx512(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t n, int op)
+{
+	size_t size;
+	size_t i;
+	__m512i a;
+	__m512i b;
+
+	size = n * sizeof(*x);
+	b = _mm512_set1_epi32(-1);
+	i = 0;
+	while ((i + 64) <= size) {
+		a = _mm512_loadu_si512((const unsigned char *)x + i);
+		if (op != ONE)
+			b = _mm512_loadu_si512((const unsigned char *)y + i);
+		switch (op) {
+		case AND:
+			a = _mm512_and_si512(a, b);
+			break;
+		case IOR:
+			a = _mm512_or_si512(a, b);
+			break;
+		default:
+			a = _mm512_xor_si512(a, b);
+			break;
+		}
+		_mm512_storeu_si512((unsigned char *)r + i, a);
+		i += 64;
+	}
+	i /= sizeof(*x);
+	bitwise_c(r + i, x + i, y + i, n - i, op);
+	return;
+}
+
+static void bitwise_init(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t n, int op);
+
+static void (*bitwise)(AUI_TYPE *, const AUI_TYPE *, const AUI_TYPE *, size_t, int) = bitwise_init;
+
+static void bitwise_init(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t n, int op)
+{
+	if (cpu() & CPU_AVX512F)
+		bitwise = bitwise_avx512;
+	else if (cpu() & CPU_AVX2)
+		bitwise = bitwise_avx2;
+	else
+		bitwise = bitwise_c;
+	bitwise(r, x, y, n, op);
+	return;
+}
+#else
+#define bitwise bitwise_c
+#endif
+
+/*
+ * Shift kernels: r = x << bits and r = x >> bits over n limbs, n > 0 and
+ * 0 < bits < AUI_TYPE_BIT. lshift allows r >= x and rshift allows r <= x,
+ * so both may shift whole limbs at the same time. Each returns the bits
+ * shifted out, in the low bits for lshift and in the high bits for rshift.
+ */
+static AUI_TYPE lshift_c(AUI_TYPE *r, const AUI_TYPE *x, size_t n, unsigned int bits)
+{
+	AUI_TYPE out;
+
+	out = x[n - 1] >> (AUI_TYPE_BIT - bits);
+	while (--n)
+		r[n] = (x[n] << bits) | (x[n - 1] >> (AUI_TYPE_BIT - bits));
+	r[0] = x[0] << bits;
+	return out;
+}
+
+static AUI_TYPE rshift_c(AUI_TYPE *r, const AUI_TYPE *x, size_t n, unsigned int bits)
+{
+	AUI_TYPE out;
+	size_t i;
+
+	out = x[0] << (AUI_TYPE_BIT - bits);
+	i = 0;
+	while (++i < n)
+		r[i - 1] = (x[i - 1] >> bits) | (x[i] << (AUI_TYPE_BIT - bits));
+	r[n - 1] = x[n - 1] >> bits;
+	return out;
+}
+
+#ifdef CPU_X86
+/*
+ * Vector shift kernels over blocks of 64 bytes. On x86 the limbs form one
+ * little-endian integer, so the shift may be done in 64-bit lanes for any
+ * AUI_TYPE. lshift carries in from the 8 bytes below x, working downwards;
+ * rshift carries in from the 8 bytes above the last block, working upwards.
+ */
+__attribute__((target("avx2")))
+static void lshift_avx2(unsigned char *r, const unsigned char *x, size_t blocks, unsigned int bits)
+{
+	__m128i left;
+	__m128i right;
+	__m256i a;
+	__m256i b;
+	size_t i;
+
+	left = _mm_cvtsi32_si128(bits);
+	right = _mm_cvtsi32_si128(64 - bits);
+	i = blocks * 2;
 	while (i--) {
-		most[(AUI_TYPE)((AUI_TYPE_MAX >> (AUI_TYPE_BIT - 1 - i)) * debruijn) >> shift] = i;
-		least[(AUI_TYPE)((1 << i) * debruijn) >> shift] = i;
+		a = _mm256_loadu_si256((const __m256i *)(x + 32 * i));
+		b = _mm256_loadu_si256((const __m256i *)(x + 32 * i - 8));
+		a = _mm256_or_si256(_mm256_sll_epi64(a, left), _mm256_srl_epi64(b, right));
+		_mm256_storeu_si256((__m256i *)(r + 32 * i), a);
+	}
+	return;
+}
+
+__attribute__((target("avx2")))
+static void rshift_avx2(unsigned char *r, const unsigned char *x, size_t blocks, unsigned int bits)
+{
+	__m128i left;
+	__m128i right;
+	__m256i a;
+	__m256i b;
+	size_t i;
+
+	left = _mm_cvtsi32_si128(64 - bits);
+	right = _mm_cvtsi32_si128(bits);
+	i = 0;
+	while (i < blocks * 2) {
+		a = _mm256_loadu_si256((const __m256i *)(x + 32 * i));
+		b = _mm256_loadu_si256((const __m256i *)(x + 32 * i + 8));
+		a = _mm256_or_si256(_mm256_srl_epi64(a, right), _mm256_sll_epi64(b, left));
+		_mm256_storeu_si256((__m256i *)(r + 32 * i), a);
+		i++;
+	}
+	return;
+}
+
+/* VPSHLDVQ and VPSHRDVQ funnel-shift each lane with its neighbour in one instruction */
+__attribute__((target("avx512f,avx512vbmi2")))
+static void lshift_avx512(unsigned char *r, const unsigned char *x, size_t blocks, unsigned int bits)
+{
+	__m512i count;
+	__m512i a;
+	__m512i b;
+
+	count = _mm512_set1_epi64(bits);
+	while (blocks--) {
+		a = _mm512_loadu_si512(x + 64 * blocks);
+		b = _mm512_loadu_si512(x + 64 * blocks - 8);
+		_mm512_storeu_si512(r + 64 * blocks, _mm512_shldv_epi64(a, b, count));
+	}
+	return;
+}
+
+__attribute__((target("avx512f,avx512vbmi2")))
+static void rshift_avx512(unsigned char *r, const unsigned char *x, size_t blocks, unsigned int bits)
+{
+	__m512i count;
+	__m512i a;
+	__m512i b;
+	size_t i;
+
+	count = _mm512_set1_epi64(bits);
+	i = 0;
+	while (i < blocks) {
+		a = _mm512_loadu_si512(x + 64 * i);
+		b = _mm512_loadu_si512(x + 64 * i + 8);
+		_mm512_storeu_si512(r + 64 * i, _mm512_shrdv_epi64(a, b, count));
+		i++;
+	}
+	return;
+}
+
+static void shift_init(void);
+
+static int shift_selected = 0;
+static void (*lshift_blocks)(unsigned char *, const unsigned char *, size_t, unsigned int);
+static void (*rshift_blocks)(unsigned char *, const unsigned char *, size_t, unsigned int);
+
+static void shift_init(void)
+{
+	if ((cpu() & (CPU_AVX512F | CPU_AVX512VBMI2)) == (CPU_AVX512F | CPU_AVX512VBMI2)) {
+		lshift_blocks = lshift_avx512;
+		rshift_blocks = rshift_avx512;
+	} else if (cpu() & CPU_AVX2) {
+		lshift_blocks = lshift_avx2;
+		rshift_blocks = rshift_avx2;
+	}
+	shift_selected = 1;
+	return;
+}
+#endif
+
+static AUI_TYPE lshift(AUI_TYPE *r, const AUI_TYPE *x, size_t n, unsigned int bits)
+{
+#ifdef CPU_X86
+	AUI_TYPE out;
+	size_t blocks;
+	size_t i;
+
+	if (!shift_selected)
+		shift_init();
+	if (!lshift_blocks || ((n * sizeof(*x)) < (8 + 64)))
+		return lshift_c(r, x, n, bits);
+	/* the blocks start after the lowest 8 bytes, which have no carry-in */
+	blocks = (n * sizeof(*x) - 8) / 64;
+	i = (8 + 64 * blocks) / sizeof(*x);
+	out = x[n - 1] >> (AUI_TYPE_BIT - bits);
+	if (i < n) {
+		lshift_c(r + i, x + i, n - i, bits);
+		r[i] |= x[i - 1] >> (AUI_TYPE_BIT - bits);
 	}
+	lshift_blocks((unsigned char *)r + 8, (const unsigned char *)x + 8, blocks, bits);
+	lshift_c(r, x, 8 / sizeof(*x), bits);
+	return out;
+#else
+	return lshift_c(r, x, n, bits);
+#endif
+}
+
+static AUI_TYPE rshift(AUI_TYPE *r, const AUI_TYPE *x, size_t n, unsigned int bits)
+{
+#ifdef CPU_X86
+	AUI_TYPE out;
+	size_t blocks;
+	size_t i;
+
+	if (!shift_selected)
+		shift_init();
+	if (!rshift_blocks || ((n * sizeof(*x)) < (8 + 64)))
+		return rshift_c(r, x, n, bits);
+	/* the blocks end at least 8 bytes before the highest limb */
+	blocks = (n * sizeof(*x) - 8) / 64;
+	i = (64 * blocks) / sizeof(*x);
+	out = x[0] << (AUI_TYPE_BIT - bits);
+	rshift_blocks((unsigned char *)r, (const unsigned char *)x, blocks, bits);
+	rshift_c(r + i, x + i, n - i, bits);
+	return out;
+#else
+	return rshift_c(r, x, n, bits);
+#endif
+}
+
+/*
+ * Shifted add and subtract kernels: x += y << bits and x -= y << bits over
+ * n limbs, 0 < bits < AUI_TYPE_BIT, shifting y on the fly; x must not
+ * overlap y. Each returns the carry (or borrow), not including the bits
+ * shifted out of y[n - 1].
+ */
+static AUI_TYPE addshl_n_c(AUI_TYPE *x, const AUI_TYPE *y, size_t n, unsigned int bits)
+{
+	AUI_TYPE carry;
+	AUI_TYPE shifted;
+	AUI_TYPE sum;
+	AUI_TYPE out;
+	size_t i;
+
+	carry = 0;
+	out = 0;
+	i = 0;
+	while (i < n) {
+		shifted = (y[i] << bits) | out;
+		out = y[i] >> (AUI_TYPE_BIT - bits);
+		sum = x[i] + carry;
+		carry = (sum < carry);
+		x[i] = sum + shifted;
+		carry += (x[i] < sum);
+		i++;
+	}
+	return carry;
+}
+
+static AUI_TYPE subshl_n_c(AUI_TYPE *x, const AUI_TYPE *y, size_t n, unsigned int bits)
+{
+	AUI_TYPE borrow;
+	AUI_TYPE shifted;
+	AUI_TYPE binary;
+	AUI_TYPE difference;
+	AUI_TYPE out;
+	size_t i;
+
+	borrow = 0;
+	out = 0;
+	i = 0;
+	while (i < n) {
+		shifted = (y[i] << bits) | out;
+		out = y[i] >> (AUI_TYPE_BIT - bits);
+		binary = x[i];
+		difference = binary - shifted;
+		x[i] = difference - borrow;
+		borrow = (difference > binary) | (difference < borrow);
+		i++;
+	}
+	return borrow;
+}
+
+#ifdef CPU_X86_64
+/*
+ * SHLX and SHRX leave the flags alone, and the two halves of the shifted
+ * limb have no bits in common, so LEA can join them inside the carry chain.
+ */
+__attribute__((target("bmi2")))
+static AUI_TYPE addshl_n_bmi2(AUI_TYPE *x, const AUI_TYPE *y, size_t n, unsigned int bits)
+{
+	AUI_TYPE count;
+	AUI_TYPE right;
+	AUI_TYPE left;
+	AUI_TYPE carry;
+	AUI_TYPE shifted;
+	AUI_TYPE binary;
+	AUI_TYPE out;
+
+	if (!n)
+		return 0;
+	count = n;
+	left = bits;
+	right = AUI_TYPE_BIT - bits;
+	__asm__ __volatile__ (
+		"xorl %k[out], %k[out]\n\t"
+		"1:\n\t"
+		"movq (%[y]), %[binary]\n\t"
+		"shlxq %[left], %[binary], %[shifted]\n\t"
+		"shrxq %[right], %[binary], %[binary]\n\t"
+		"leaq (%[shifted], %[out]), %[shifted]\n\t"
+		"movq %[binary], %[out]\n\t"
+		"adcq %[shifted], (%[x])\n\t"
+		"leaq 8(%[x]), %[x]\n\t"
+		"leaq 8(%[y]), %[y]\n\t"
+		"decq %[count]\n\t"
+		"jnz 1b\n\t"
+		"movl $0, %k[carry]\n\t"
+		"adcl $0, %k[carry]\n\t"
+		: [x] "+r" (x), [y] "+r" (y), [count] "+r" (count), [carry] "=&r" (carry),
+		  [shifted] "=&r" (shifted), [binary] "=&r" (binary), [out] "=&r" (out)
+		: [left] "r" (left), [right] "r" (right)
+		: "cc", "memory");
+	return carry;
+}
+
+__attribute__((target("bmi2")))
+static AUI_TYPE subshl_n_bmi2(AUI_TYPE *x, const AUI_TYPE *y, size_t n, unsigned int bits)
+{
+	AUI_TYPE count;
+	AUI_TYPE right;
+	AUI_TYPE left;
+	AUI_TYPE borrow;
+	AUI_TYPE shifted;
+	AUI_TYPE binary;
+	AUI_TYPE out;
+
+	if (!n)
+		return 0;
+	count = n;
+	left = bits;
+	right = AUI_TYPE_BIT - bits;
+	__asm__ __volatile__ (
+		"xorl %k[out], %k[out]\n\t"
+		"1:\n\t"
+		"movq (%[y]), %[binary]\n\t"
+		"shlxq %[left], %[binary], %[shifted]\n\t"
+		"shrxq %[right], %[binary], %[binary]\n\t"
+		"leaq (%[shifted], %[out]), %[shifted]\n\t"
+		"movq %[binary], %[out]\n\t"
+		"sbbq %[shifted], (%[x])\n\t"
+		"leaq 8(%[x]), %[x]\n\t"
+		"leaq 8(%[y]), %[y]\n\t"
+		"decq %[count]\n\t"
+		"jnz 1b\n\t"
+		"movl $0, %k[borrow]\n\t"
+		"adcl $0, %k[borrow]\n\t"
+		: [x] "+r" (x), [y] "+r" (y), [count] "+r" (count), [borrow] "=&r" (borrow),
+		  [shifted] "=&r" (shifted), [binary] "=&r" (binary), [out] "=&r" (out)
+		: [left] "r" (left), [right] "r" (right)
+		: "cc", "memory");
+	return borrow;
+}
+
+static AUI_TYPE addshl_n_init(AUI_TYPE *x, const AUI_TYPE *y, size_t n, unsigned int bits);
+static AUI_TYPE subshl_n_init(AUI_TYPE *x, const AUI_TYPE *y, size_t n, unsigned int bits);
+
+static AUI_TYPE (*addshl_n)(AUI_TYPE *, const AUI_TYPE *, size_t, unsigned int) = addshl_n_init;
+static AUI_TYPE (*subshl_n)(AUI_TYPE *, const AUI_TYPE *, size_t, unsigned int) = subshl_n_init;
+
+static AUI_TYPE addshl_n_init(AUI_TYPE *x, const AUI_TYPE *y, size_t n, unsigned int bits)
+{
+	addshl_n = (cpu() & CPU_BMI2) ? addshl_n_bmi2 : addshl_n_c;
+	return addshl_n(x, y, n, bits);
+}
+
+static AUI_TYPE subshl_n_init(AUI_TYPE *x, const AUI_TYPE *y, size_t n, unsigned int bits)
+{
+	subshl_n = (cpu() & CPU_BMI2) ? subshl_n_bmi2 : subshl_n_c;
+	return subshl_n(x, y, n, bits);
+}
+#else
+#define addshl_n addshl_n_c
+#define subshl_n subshl_n_c
+#endif
+
+/*
+ * (hi, lo) / d for hi < d; returns the remainder and stores the quotient in
+ * *q. Without a double-width type, d must be normalized (its most
+ * significant bit set) and the division is done in half limbs.
+ */
+static AUI_TYPE div_ll(AUI_TYPE *q, AUI_TYPE hi, AUI_TYPE lo, AUI_TYPE d)
+{
+#ifdef WIDE
+	wide dividend;
+
+	dividend = ((wide)hi << AUI_TYPE_BIT) | lo;
+	*q = dividend / d;
+	return dividend % d;
+#else
+	AUI_TYPE half;
+	AUI_TYPE mask;
+	AUI_TYPE q1;
+	AUI_TYPE q0;
+	AUI_TYPE r;
+	AUI_TYPE middle;
+
+	half = (AUI_TYPE)1 << (AUI_TYPE_BIT / 2);
+	mask = half - 1;
+	q1 = hi / (d >> (AUI_TYPE_BIT / 2));
+	r = hi - q1 * (d >> (AUI_TYPE_BIT / 2));
+	while ((q1 >= half) || ((q1 * (d & mask)) > ((r << (AUI_TYPE_BIT / 2)) | (lo >> (AUI_TYPE_BIT / 2))))) {
+		q1--;
+		if ((r += (d >> (AUI_TYPE_BIT / 2))) >= half)
+			break;
+	}
+	middle = (hi << (AUI_TYPE_BIT / 2)) + (lo >> (AUI_TYPE_BIT / 2)) - q1 * d;
+	q0 = middle / (d >> (AUI_TYPE_BIT / 2));
+	r = middle - q0 * (d >> (AUI_TYPE_BIT / 2));
+	while ((q0 >= half) || ((q0 * (d & mask)) > ((r << (AUI_TYPE_BIT / 2)) | (lo & mask)))) {
+		q0--;
+		if ((r += (d >> (AUI_TYPE_BIT / 2))) >= half)
+			break;
+	}
+	*q = (q1 << (AUI_TYPE_BIT / 2)) | q0;
+	return (middle << (AUI_TYPE_BIT / 2)) + (lo & mask) - q0 * d;
+#endif
+}
+
+/* r = x / d over n limbs, returning x % d; r may be x, or NULL */
+static AUI_TYPE divmod_1(AUI_TYPE *r, const AUI_TYPE *x, size_t n, AUI_TYPE d)
+{
+	unsigned int shift;
+	AUI_TYPE remainder;
+	AUI_TYPE quotient;
+	AUI_TYPE lo;
+
+	shift = AUI_TYPE_BIT - 1 - aui_msbn(d);
+	d <<= shift;
+	remainder = 0;
+	if (shift && n)
+		remainder = x[n - 1] >> (AUI_TYPE_BIT - shift);
+	while (n--) {
+		lo = x[n] << shift;
+		if (shift && n)
+			lo |= x[n - 1] >> (AUI_TYPE_BIT - shift);
+		remainder = div_ll(&quotient, remainder, lo, d);
+		if (r)
+			r[n] = quotient;
+	}
+	return remainder >> shift;
+}
+
+/*
+ * q = x / y and r = x % y, for n >= m >= 2 and y[m - 1] != 0 (Knuth's
+ * algorithm D); q (n - m + 1 limbs) and r (m limbs) may be NULL. Returns 0
+ * if out of memory.
+ */
+static int divmod_n(AUI_TYPE *q, AUI_TYPE *r, const AUI_TYPE *x, size_t n, const AUI_TYPE *y, size_t m)
+{
+	AUI_TYPE *u;
+	AUI_TYPE *v;
+	AUI_TYPE estimate;
+	AUI_TYPE remainder;
+	AUI_TYPE borrow;
+	AUI_TYPE carry;
+	AUI_TYPE hi;
+	AUI_TYPE lo;
+	unsigned int shift;
+	size_t j;
+
+	if (!(u = malloc(sizeof(*u) * (n + 1 + m))))
+		return 0;
+	v = u + n + 1;
+	shift = AUI_TYPE_BIT - 1 - aui_msbn(y[m - 1]);
+	if (shift) {
+		lshift_c(v, y, m, shift);
+		u[n] = lshift_c(u, x, n, shift);
+	} else {
+		memcpy(v, y, sizeof(*v) * m);
+		memcpy(u, x, sizeof(*u) * n);
+		u[n] = 0;
+	}
+	j = n - m + 1;
+	while (j--) {
+		if (u[j + m] >= v[m - 1]) {
+			estimate = AUI_TYPE_MAX;
+			remainder = u[j + m - 1] + v[m - 1];
+			if (remainder < v[m - 1])
+				goto subtract;
+		} else {
+			remainder = div_ll(&estimate, u[j + m], u[j + m - 1], v[m - 1]);
+		}
+		lo = mul_ll(&hi, estimate, v[m - 2]);
+		while ((hi > remainder) || ((hi == remainder) && (lo > u[j + m - 2]))) {
+			estimate--;
+			if ((remainder += v[m - 1]) < v[m - 1])
+				break;
+			lo = mul_ll(&hi, estimate, v[m - 2]);
+		}
+subtract:
+		borrow = submul_1(u + j, v, m, estimate);
+		hi = u[j + m];
+		u[j + m] = hi - borrow;
+		if (borrow > hi) {
+			do {
+				estimate--;
+				carry = add_n(u + j, u + j, v, m, 0);
+				u[j + m] += carry;
+			} while (u[j + m] >= carry);
+		}
+		if (q)
+			q[j] = estimate;
+	}
+	if (r) {
+		if (shift)
+			rshift_c(r, u, m, shift);
+		else
+			memcpy(r, u, sizeof(*r) * m);
+	}
+	free(u);
+	return 1;
+}
+
+/*
+ * Scan kernels over n limbs: lowest returns the index of the lowest
+ * non-zero limb (n if none), highest the number of limbs up to and
+ * including the highest non-zero limb (0 if none), and differ the number
+ * of limbs up to and including the highest limb where x and y differ.
+ */
+static size_t lowest_c(const AUI_TYPE *x, size_t n)
+{
+	size_t i;
+
+	i = 0;
+	while ((i < n) && !x[i])
+		i++;
+	return i;
+}
+
+static size_t highest_c(const AUI_TYPE *x, size_t n)
+{
+	while (n && !x[n - 1])
+		n--;
+	return n;
+}
+
+static size_t differ_c(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	while (n && (x[n - 1] == y[n - 1]))
+		n--;
+	return n;
+}
+
+#ifdef CPU_X86
+/*
+ * The vector scans test 64 bytes at a time, then locate the byte with
+ * MOVEMASK (AVX2) or a mask register (AVX-512) and a bit scan.
+ */
+__attribute__((target("avx2")))
+static size_t lowest_avx2(const AUI_TYPE *x, size_t n)
+{
+	const unsigned char *p;
+	size_t size;
+	size_t i;
+	unsigned int mask;
+	__m256i a;
+	__m256i b;
+
+	p = (const unsigned char *)x;
+	size = n * sizeof(*x);
+	i = 0;
+	while ((i + 64) <= size) {
+		a = _mm256_loadu_si256((const __m256i *)(p + i));
+		b = _mm256_loadu_si256((const __m256i *)(p + i + 32));
+		if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+			if (_mm256_testz_si256(a, a)) {
+				a = b;
+				i += 32;
+			}
+			mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()));
+			return (i + __builtin_ctz(mask)) / sizeof(*x);
+		}
+		i += 64;
+	}
+	i /= sizeof(*x);
+	return i + lowest_c(x + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static size_t highest_avx2(const AUI_TYPE *x, size_t n)
+{
+	const unsigned char *p;
+	size_t i;
+	size_t j;
+	unsigned int mask;
+	__m256i a;
+	__m256i b;
+
+	p = (const unsigned char *)x;
+	i = (n * sizeof(*x)) & ~(size_t)63;
+	j = i / sizeof(*x);
+	if ((j = highest_c(x + j, n - j)))
+		return i / sizeof(*x) + j;
+	while (i) {
+		i -= 64;
+		a = _mm256_loadu_si256((const __m256i *)(p + i));
+		b = _mm256_loadu_si256((const __m256i *)(p + i + 32));
+		if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+			if (!_mm256_testz_si256(b, b)) {
+				a = b;
+				i += 32;
+			}
+			mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()));
+			return (i + 31 - __builtin_clz(mask)) / sizeof(*x) + 1;
+		}
+	}
+	return 0;
+}
+
+__attribute__((target("avx2")))
+static size_t differ_avx2(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	const unsigned char *p;
+	const unsigned char *q;
+	size_t i;
+	size_t j;
+	unsigned int mask;
+	__m256i a;
+	__m256i b;
+
+	p = (const unsigned char *)x;
+	q = (const unsigned char *)y;
+	i = (n * sizeof(*x)) & ~(size_t)63;
+	j = i / sizeof(*x);
+	if ((j = differ_c(x + j, y + j, n - j)))
+		return i / sizeof(*x) + j;
+	while (i) {
+		i -= 64;
+		a = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(p + i)),
+			_mm256_loadu_si256((const __m256i *)(q + i)));
+		b = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(p + i + 32)),
+			_mm256_loadu_si256((const __m256i *)(q + i + 32)));
+		if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+			if (!_mm256_testz_si256(b, b)) {
+				a = b;
+				i += 32;
+			}
+			mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()));
+			return (i + 31 - __builtin_clz(mask)) / sizeof(*x) + 1;
+		}
+	}
+	return 0;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t lowest_avx512(const AUI_TYPE *x, size_t n)
+{
+	const unsigned char *p;
+	size_t size;
+	size_t i;
+	__m512i a;
+	__mmask64 mask;
+
+	p = (const unsigned char *)x;
+	size = n * sizeof(*x);
+	i = 0;
+	while ((i + 64) <= size) {
+		a = _mm512_loadu_si512(p + i);
+		if ((mask = _mm512_test_epi8_mask(a, a)))
+			return (i + __builtin_ctzll(mask)) / sizeof(*x);
+		i += 64;
+	}
+	i /= sizeof(*x);
+	return i + lowest_c(x + i, n - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t highest_avx512(const AUI_TYPE *x, size_t n)
+{
+	const unsigned char *p;
+	size_t i;
+	size_t j;
+	__m512i a;
+	__mmask64 mask;
+
+	p = (const unsigned char *)x;
+	i = (n * sizeof(*x)) & ~(size_t)63;
+	j = i / sizeof(*x);
+	if ((j = highest_c(x + j, n - j)))
+		return i / sizeof(*x) + j;
+	while (i) {
+		i -= 64;
+		a = _mm512_loadu_si512(p + i);
+		if ((mask = _mm512_test_epi8_mask(a, a)))
+			return (i + 63 - __builtin_clzll(mask)) / sizeof(*x) + 1;
+	}
+	return 0;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t differ_avx512(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	const unsigned char *p;
+	const unsigned char *q;
+	size_t i;
+	size_t j;
+	__mmask64 mask;
+
+	p = (const unsigned char *)x;
+	q = (const unsigned char *)y;
+	i = (n * sizeof(*x)) & ~(size_t)63;
+	j = i / sizeof(*x);
+	if ((j = differ_c(x + j, y + j, n - j)))
+		return i / sizeof(*x) + j;
+	while (i) {
+		i -= 64;
+		if ((mask = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(p + i), _mm512_loadu_si512(q + i))))
+			return (i + 63 - __builtin_clzll(mask)) / sizeof(*x) + 1;
+	}
+	return 0;
+}
+
+static size_t lowest_init(const AUI_TYPE *x, size_t n);
+static size_t highest_init(const AUI_TYPE *x, size_t n);
+static size_t differ_init(const AUI_TYPE *x, const AUI_TYPE *y, size_t n);
+
+static size_t (*lowest)(const AUI_TYPE *, size_t) = lowest_init;
+static size_t (*highest)(const AUI_TYPE *, size_t) = highest_init;
+static size_t (*differ)(const AUI_TYPE *, const AUI_TYPE *, size_t) = differ_init;
+
+static size_t lowest_init(const AUI_TYPE *x, size_t n)
+{
+	if ((cpu() & (CPU_AVX512F | CPU_AVX512BW)) == (CPU_AVX512F | CPU_AVX512BW))
+		lowest = lowest_avx512;
+	else if (cpu() & CPU_AVX2)
+		lowest = lowest_avx2;
+	else
+		lowest = lowest_c;
+	return lowest(x, n);
+}
+
+static size_t highest_init(const AUI_TYPE *x, size_t n)
+{
+	if ((cpu() & (CPU_AVX512F | CPU_AVX512BW)) == (CPU_AVX512F | CPU_AVX512BW))
+		highest = highest_avx512;
+	else if (cpu() & CPU_AVX2)
+		highest = highest_avx2;
+	else
+		highest = highest_c;
+	return highest(x, n);
+}
+
+static size_t differ_init(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	if ((cpu() & (CPU_AVX512F | CPU_AVX512BW)) == (CPU_AVX512F | CPU_AVX512BW))
+		differ = differ_avx512;
+	else if (cpu() & CPU_AVX2)
+		differ = differ_avx2;
+	else
+		differ = differ_c;
+	return differ(x, y, n);
+}
+#else
+#define lowest lowest_c
+#define highest highest_c
+#define differ differ_c
+#endif
+
+/* population count of x, or of x ^ y unless y is NULL, over n limbs */
+static size_t popcount_c(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	size_t count;
+	AUI_TYPE binary;
+
+	count = 0;
+	while (n--) {
+		binary = y ? (x[n] ^ y[n]) : x[n];
+#ifdef BUILTIN_POPCOUNT
+		count += BUILTIN_POPCOUNT(binary);
+#else
+		binary -= (binary >> 1) & (AUI_TYPE_MAX / 3);
+		binary = (binary & (AUI_TYPE_MAX / 5)) + ((binary >> 2) & (AUI_TYPE_MAX / 5));
+		binary = (binary + (binary >> 4)) & (AUI_TYPE_MAX / 17);
+		count += (AUI_TYPE)(binary * (AUI_TYPE_MAX / 255)) >> (AUI_TYPE_BIT - 8);
+#endif
+	}
+	return count;
+}
+
+#ifdef CPU_X86
+/* POPCNT on native words, any AUI_TYPE */
+__attribute__((target("popcnt")))
+static size_t popcount_popcnt(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	size_t count;
+	unsigned long a;
+	unsigned long b;
+	size_t size;
+	size_t i;
+
+	count = 0;
+	size = n * sizeof(*x);
+	i = 0;
+	while ((i + sizeof(a)) <= size) {
+		memcpy(&a, (const unsigned char *)x + i, sizeof(a));
+		if (y) {
+			memcpy(&b, (const unsigned char *)y + i, sizeof(b));
+			a ^= b;
+		}
+		count += __builtin_popcountl(a);
+		i += sizeof(a);
+	}
+	i /= sizeof(*x);
+	return count + popcount_c(x + i, y ? (y + i) : NULL, n - i);
+}
+
+#ifdef __x86_64__
+/*
+ * Nibble lookup with VPSHUFB; the byte counts are accumulated for up to 31
+ * vectors (at most 8 * 31 per byte) before being summed with VPSADBW.
+ */
+__attribute__((target("avx2,popcnt")))
+static size_t popcount_avx2(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	const unsigned char *p;
+	const unsigned char *q;
+	size_t size;
+	size_t i;
+	size_t j;
+	__m256i table;
+	__m256i mask;
+	__m256i a;
+	__m256i bytes;
+	__m256i total;
+
+	p = (const unsigned char *)x;
+	q = (const unsigned char *)y;
+	size = n * sizeof(*x);
+	table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	mask = _mm256_set1_epi8(0x0F);
+	total = _mm256_setzero_si256();
+	i = 0;
+	while ((i + 32) <= size) {
+		bytes = _mm256_setzero_si256();
+		j = 31;
+		while (j-- && ((i + 32) <= size)) {
+			a = _mm256_loadu_si256((const __m256i *)(p + i));
+			if (q)
+				a = _mm256_xor_si256(a, _mm256_loadu_si256((const __m256i *)(q + i)));
+			bytes = _mm256_add_epi8(bytes, _mm256_shuffle_epi8(table, _mm256_and_si256(a, mask)));
+			bytes = _mm256_add_epi8(bytes, _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(a, 4), mask)));
+			i += 32;
+		}
+		total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+	}
+	i /= sizeof(*x);
+	return (size_t)_mm256_extract_epi64(total, 0) + (size_t)_mm256_extract_epi64(total, 1)
+		+ (size_t)_mm256_extract_epi64(total, 2) + (size_t)_mm256_extract_epi64(total, 3)
+		+ popcount_popcnt(x + i, y ? (y + i) : NULL, n - i);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+static size_t popcount_avx512(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	const unsigned char *p;
+	const unsigned char *q;
+	size_t size;
+	size_t i;
+	__m512i a;
+	__m512i total;
+
+	p = (const unsigned char *)x;
+	q = (const unsigned char *)y;
+	size = n * sizeof(*x);
+	total = _mm512_setzero_si512();
+	i = 0;
+	while ((i + 64) <= size) {
+		a = _mm512_loadu_si512(p + i);
+		if (q)
+			a = _mm512_xor_si512(a, _mm512_loadu_si512(q + i));
+		total = _mm512_add_epi64(total, _mm512_popcnt_epi64(a));
+		i += 64;
+	}
+	i /= sizeof(*x);
+	return (size_t)_mm512_reduce_add_epi64(total)
+		+ popcount_popcnt(x + i, y ? (y + i) : NULL, n - i);
+}
+#endif
+
+static size_t popcount_init(const AUI_TYPE *x, const AUI_TYPE *y, size_t n);
+
+static size_t (*popcount)(const AUI_TYPE *, const AUI_TYPE *, size_t) = popcount_init;
+
+static size_t popcount_init(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
+{
+	popcount = popcount_c;
+	if (cpu() & CPU_POPCNT)
+		popcount = popcount_popcnt;
+#ifdef __x86_64__
+	if ((cpu() & (CPU_AVX2 | CPU_POPCNT)) == (CPU_AVX2 | CPU_POPCNT))
+		popcount = popcount_avx2;
+	if ((cpu() & (CPU_AVX512F | CPU_AVX512VPOPCNTDQ | CPU_POPCNT)) == (CPU_AVX512F | CPU_AVX512VPOPCNTDQ | CPU_POPCNT))
+		popcount = popcount_avx512;
+#endif
+	return popcount(x, y, n);
+}
+#else
+#define popcount popcount_c
+#endif
+
+/*
+ * Lane kernels for struct aui_vector: limb i of lane j is at x[i * stride + j],
+ * and n lanes are processed, each with its own carry chain.
+ */
+static void lanes_add_c(AUI_TYPE *x, const AUI_TYPE *y, size_t length, size_t stride, size_t n)
+{
+	size_t i;
+	size_t j;
+	AUI_TYPE carry;
+	AUI_TYPE sum;
+
+	j = 0;
+	while (j < n) {
+		carry = 0;
+		i = 0;
+		while (i < length) {
+			sum = x[i * stride + j] + carry;
+			carry = (sum < carry);
+			x[i * stride + j] = sum + y[i * stride + j];
+			carry += (x[i * stride + j] < sum);
+			i++;
+		}
+		j++;
+	}
+	return;
+}
+
+/* r = x - y unless r is NULL, storing the borrow of each lane unless borrow is NULL */
+static void lanes_sub_c(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t length, size_t stride, size_t n, AUI_TYPE *borrow)
+{
+	size_t i;
+	size_t j;
+	AUI_TYPE carry;
+	AUI_TYPE binary;
+	AUI_TYPE difference;
+
+	j = 0;
+	while (j < n) {
+		carry = 0;
+		i = 0;
+		while (i < length) {
+			binary = x[i * stride + j];
+			difference = binary - y[i * stride + j];
+			if (r)
+				r[i * stride + j] = difference - carry;
+			carry = (difference > binary) | (difference < carry);
+			i++;
+		}
+		if (borrow)
+			borrow[j] = carry;
+		j++;
+	}
+	return;
+}
+
+#ifdef CPU_X86
+/*
+ * The carry (borrow) out of each lane is the most significant bit of
+ * (x & y) | ((x | y) & ~sum), or (~x & y) | (~(x ^ y) & difference).
+ */
+#if (AUI_TYPE_BIT == 8)
+#define LANES_ADD _mm256_add_epi8
+#define LANES_SUB _mm256_sub_epi8
+#define LANES_MSB(a) _mm256_and_si256(_mm256_srli_epi16((a), 7), _mm256_set1_epi8(1))
+#elif (AUI_TYPE_BIT == 16)
+#define LANES_ADD _mm256_add_epi16
+#define LANES_SUB _mm256_sub_epi16
+#define LANES_MSB(a) _mm256_srli_epi16((a), 15)
+#elif (AUI_TYPE_BIT == 32)
+#define LANES_ADD _mm256_add_epi32
+#define LANES_SUB _mm256_sub_epi32
+#define LANES_MSB(a) _mm256_srli_epi32((a), 31)
+#else
+#define LANES_ADD _mm256_add_epi64
+#define LANES_SUB _mm256_sub_epi64
+#define LANES_MSB(a) _mm256_srli_epi64((a), 63)
+#endif
+
+__attribute__((target("avx2")))
+static void lanes_add_avx2(AUI_TYPE *x, const AUI_TYPE *y, size_t length, size_t stride, size_t n)
+{
+	size_t i;
+	size_t j;
+	__m256i a;
+	__m256i b;
+	__m256i sum;
+	__m256i carry;
+
+	j = 0;
+	while ((j + 32 / sizeof(*x)) <= n) {
+		carry = _mm256_setzero_si256();
+		i = 0;
+		while (i < length) {
+			a = _mm256_loadu_si256((const __m256i *)(x + i * stride + j));
+			b = _mm256_loadu_si256((const __m256i *)(y + i * stride + j));
+			sum = LANES_ADD(LANES_ADD(a, b), carry);
+			carry = LANES_MSB(_mm256_or_si256(_mm256_and_si256(a, b),
+				_mm256_andnot_si256(sum, _mm256_or_si256(a, b))));
+			_mm256_storeu_si256((__m256i *)(x + i * stride + j), sum);
+			i++;
+		}
+		j += 32 / sizeof(*x);
+	}
+	lanes_add_c(x + j, y + j, length, stride, n - j);
+	return;
+}
+
+__attribute__((target("avx2")))
+static void lanes_sub_avx2(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t length, size_t stride, size_t n, AUI_TYPE *borrow)
+{
+	size_t i;
+	size_t j;
+	__m256i a;
+	__m256i b;
+	__m256i difference;
+	__m256i carry;
+
+	j = 0;
+	while ((j + 32 / sizeof(*x)) <= n) {
+		carry = _mm256_setzero_si256();
+		i = 0;
+		while (i < length) {
+			a = _mm256_loadu_si256((const __m256i *)(x + i * stride + j));
+			b = _mm256_loadu_si256((const __m256i *)(y + i * stride + j));
+			difference = LANES_SUB(LANES_SUB(a, b), carry);
+			carry = LANES_MSB(_mm256_or_si256(_mm256_andnot_si256(a, b),
+				_mm256_andnot_si256(_mm256_xor_si256(a, b), difference)));
+			if (r)
+				_mm256_storeu_si256((__m256i *)(r + i * stride + j), difference);
+			i++;
+		}
+		if (borrow)
+			_mm256_storeu_si256((__m256i *)(borrow + j), carry);
+		j += 32 / sizeof(*x);
+	}
+	lanes_sub_c(r ? (r + j) : NULL, x + j, y + j, length, stride, n - j, borrow ? (borrow + j) : NULL);
+	return;
+}
+
+static void lanes_add_init(AUI_TYPE *x, const AUI_TYPE *y, size_t length, size_t stride, size_t n);
+static void lanes_sub_init(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t length, size_t stride, size_t n, AUI_TYPE *borrow);
+
+static void (*lanes_add)(AUI_TYPE *, const AUI_TYPE *, size_t, size_t, size_t) = lanes_add_init;
+static void (*lanes_sub)(AUI_TYPE *, const AUI_TYPE *, const AUI_TYPE *, size_t, size_t, size_t, AUI_TYPE *) = lanes_sub_init;
+
+static void lanes_add_init(AUI_TYPE *x, const AUI_TYPE *y, size_t length, size_t stride, size_t n)
+{
+	lanes_add = (cpu() & CPU_AVX2) ? lanes_add_avx2 : lanes_add_c;
+	lanes_add(x, y, length, stride, n);
+	return;
+}
+
+static void lanes_sub_init(AUI_TYPE *r, const AUI_TYPE *x, const AUI_TYPE *y, size_t length, size_t stride, size_t n, AUI_TYPE *borrow)
+{
+	lanes_sub = (cpu() & CPU_AVX2) ? lanes_sub_avx2 : lanes_sub_c;
+	lanes_sub(r, x, y, length, stride, n, borrow);
+	return;
+}
+#else
+#define lanes_add lanes_add_c
+#define lanes_sub lanes_sub_c
+#endif
+
+/*
+ * Hash kernels: every stripe of 8 unsigned longs adds each word to the
+ * neighbouring accumulator, and the product of the low and high halves of
+ * the word XOR its key to its own accumulator; the keys then step by
+ * HASH_PRIME, so that stripes don't commute. The accumulators are
+ * scrambled after every HASH_BLOCK stripes.
+ */
+#if ((ULONG_MAX >> 31 >> 31) >= 3)
+#define HASH_BIT 64
+#define HASH_PRIME 0x9E3779B97F4A7C15UL
+#define HASH_MIX1 0xBF58476D1CE4E5B9UL
+#define HASH_MIX2 0x94D049BB133111EBUL
+#define HASH_SHIFT1 30
+#define HASH_SHIFT2 27
+#define HASH_SHIFT3 31
+#else
+#define HASH_BIT 32
+#define HASH_PRIME 0x9E3779B9UL
+#define HASH_MIX1 0x85EBCA6BUL
+#define HASH_MIX2 0xC2B2AE35UL
+#define HASH_SHIFT1 16
+#define HASH_SHIFT2 13
+#define HASH_SHIFT3 16
+#endif
+#define HASH_HALF ((1UL << (HASH_BIT / 2)) - 1)
+#define HASH_STRIPE (8 * sizeof(unsigned long))
+#define HASH_BLOCK 16
+
+static unsigned long hash_mix(unsigned long h)
+{
+	h ^= h >> HASH_SHIFT1;
+	h *= HASH_MIX1;
+	h ^= h >> HASH_SHIFT2;
+	h *= HASH_MIX2;
+	h ^= h >> HASH_SHIFT3;
+	return h;
+}
+
+static void hash_stripes_c(unsigned long *acc, unsigned long *key, const unsigned char *data, size_t count)
+{
+	unsigned long word;
+	unsigned long mixed;
+	size_t i;
+
+	while (count--) {
+		i = 0;
+		while (i < 8) {
+			memcpy(&word, data + i * sizeof(word), sizeof(word));
+			mixed = word ^ key[i];
+			acc[i] += (mixed & HASH_HALF) * (mixed >> (HASH_BIT / 2));
+			acc[i ^ 1] += word;
+			key[i] += HASH_PRIME;
+			i++;
+		}
+		data += HASH_STRIPE;
+	}
+	return;
+}
+
+#if defined(CPU_X86) && (HASH_BIT == 64)
+/* _mm256_mul_epu32 multiplies the low halves; the shuffle swaps neighbouring words */
+__attribute__((target("avx2")))
+static void hash_stripes_avx2(unsigned long *acc, unsigned long *key, const unsigned char *data, size_t count)
+{
+	unsigned long prime[4];
+	__m256i acc0;
+	__m256i acc1;
+	__m256i key0;
+	__m256i key1;
+	__m256i step;
+	__m256i a;
+	__m256i b;
+
+	acc0 = _mm256_loadu_si256((const __m256i *)acc);
+	acc1 = _mm256_loadu_si256((const __m256i *)(acc + 4));
+	key0 = _mm256_loadu_si256((const __m256i *)key);
+	key1 = _mm256_loadu_si256((const __m256i *)(key + 4));
+	prime[0] = HASH_PRIME;
+	prime[1] = HASH_PRIME;
+	prime[2] = HASH_PRIME;
+	prime[3] = HASH_PRIME;
+	step = _mm256_loadu_si256((const __m256i *)prime);
+	while (count--) {
+		a = _mm256_loadu_si256((const __m256i *)data);
+		b = _mm256_xor_si256(a, key0);
+		acc0 = _mm256_add_epi64(acc0, _mm256_mul_epu32(b, _mm256_srli_epi64(b, 32)));
+		acc0 = _mm256_add_epi64(acc0, _mm256_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+		a = _mm256_loadu_si256((const __m256i *)(data + 32));
+		b = _mm256_xor_si256(a, key1);
+		acc1 = _mm256_add_epi64(acc1, _mm256_mul_epu32(b, _mm256_srli_epi64(b, 32)));
+		acc1 = _mm256_add_epi64(acc1, _mm256_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+		key0 = _mm256_add_epi64(key0, step);
+		key1 = _mm256_add_epi64(key1, step);
+		data += 64;
+	}
+	_mm256_storeu_si256((__m256i *)acc, acc0);
+	_mm256_storeu_si256((__m256i *)(acc + 4), acc1);
+	_mm256_storeu_si256((__m256i *)key, key0);
+	_mm256_storeu_si256((__m256i *)(key + 4), key1);
+	return;
+}
+
+static void hash_stripes_init(unsigned long *acc, unsigned long *key, const unsigned char *data, size_t count);
+
+static void (*hash_stripes)(unsigned long *, unsigned long *, const unsigned char *, size_t) = hash_stripes_init;
+
+static void hash_stripes_init(unsigned long *acc, unsigned long *key, const unsigned char *data, size_t count)
+{
+	hash_stripes = (cpu() & CPU_AVX2) ? hash_stripes_avx2 : hash_stripes_c;
+	hash_stripes(acc, key, data, count);
+	return;
+}
+#else
+#define hash_stripes hash_stripes_c
+#endif
+
+static void hash_start(unsigned long *acc, unsigned long *key, unsigned long seed)
+{
+	size_t i;
+
+	i = 0;
+	while (i < 8) {
+		acc[i] = 0;
+		key[i] = (seed + (i + 1) * HASH_PRIME) * HASH_MIX1;
+		i++;
+	}
+	return;
+}
+
+/* done is the number of stripes processed so far */
+static void hash_run(unsigned long *acc, unsigned long *key, size_t done, const unsigned char *data, size_t stripes)
+{
+	size_t count;
+	size_t i;
+
+	while (stripes) {
+		count = HASH_BLOCK - done % HASH_BLOCK;
+		count = (count < stripes) ? count : stripes;
+		hash_stripes(acc, key, data, count);
+		done += count;
+		data += count * HASH_STRIPE;
+		stripes -= count;
+		if (!(done % HASH_BLOCK)) {
+			i = 0;
+			while (i < 8) {
+				acc[i] = (acc[i] ^ (acc[i] >> (HASH_BIT / 2 + 15))) * HASH_PRIME;
+				i++;
+			}
+		}
+	}
+	return;
+}
+
+/* pads the last size < HASH_STRIPE bytes with zeros, then folds the accumulators */
+static unsigned long hash_end(unsigned long *acc, unsigned long *key, const unsigned char *data, size_t size, unsigned long seed, size_t total)
+{
+	unsigned long buffer[8];
+	unsigned long h;
+	size_t i;
+
+	if (size) {
+		memset(buffer, 0, sizeof(buffer));
+		memcpy(buffer, data, size);
+		hash_stripes(acc, key, (const unsigned char *)buffer, 1);
+	}
+	h = seed ^ ((unsigned long)total * HASH_PRIME);
+	i = 0;
+	while (i < 8) {
+		h += (acc[i] ^ (acc[i] >> HASH_SHIFT1)) * (HASH_MIX1 + 2 * i);
+		i++;
+	}
+	return hash_mix(h);
+}
+
+static void hash_feed(struct aui_hash_state *state, const unsigned char *data, size_t size)
+{
+	unsigned char *buffer;
+	size_t count;
+
+	buffer = (unsigned char *)state->buffer;
+	state->total += size;
+	if (state->fill) {
+		count = HASH_STRIPE - state->fill;
+		count = (count < size) ? count : size;
+		memcpy(buffer + state->fill, data, count);
+		state->fill += count;
+		data += count;
+		size -= count;
+		if (state->fill < HASH_STRIPE)
+			return;
+		hash_run(state->acc, state->key, state->stripes, buffer, 1);
+		state->stripes++;
+		state->fill = 0;
+	}
+	count = size / HASH_STRIPE;
+	hash_run(state->acc, state->key, state->stripes, data, count);
+	state->stripes += count;
+	data += count * HASH_STRIPE;
+	size -= count * HASH_STRIPE;
+	memcpy(buffer, data, size);
+	state->fill = size;
+	return;
+}
+
+/* r = the n bytes of x in reverse order; r must not overlap x */
+static void reverse_c(unsigned char *r, const unsigned char *x, size_t n)
+{
+	size_t i;
+
+	i = 0;
+	while (i < n) {
+		r[i] = x[n - 1 - i];
+		i++;
+	}
+	return;
+}
+
+#ifdef CPU_X86
+__attribute__((target("avx2")))
+static void reverse_avx2(unsigned char *r, const unsigned char *x, size_t n)
+{
+	size_t i;
+	__m256i mask;
+	__m256i a;
+
+	mask = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+		15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+	i = 0;
+	while ((i + 32) <= n) {
+		a = _mm256_loadu_si256((const __m256i *)(x + n - 32 - i));
+		a = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(a, mask), 0x4E);
+		_mm256_storeu_si256((__m256i *)(r + i), a);
+		i += 32;
+	}
+	reverse_c(r + i, x, n - i);
+	return;
+}
+
+static void reverse_init(unsigned char *r, const unsigned char *x, size_t n);
+
+static void (*reverse)(unsigned char *, const unsigned char *, size_t) = reverse_init;
+
+static void reverse_init(unsigned char *r, const unsigned char *x, size_t n)
+{
+	reverse = (cpu() & CPU_AVX2) ? reverse_avx2 : reverse_c;
+	reverse(r, x, n);
+	return;
+}
+#else
+#define reverse reverse_c
+#endif
+
+/* whether the limbs are stored least significant byte first */
+static int little(void)
+{
+	AUI_TYPE limb;
+	size_t i;
+
+	limb = 0;
+	i = sizeof(limb);
+	while (i--)
+		limb = (AUI_TYPE)(limb << CHAR_BIT) | (AUI_TYPE)i;
+	i = 0;
+	while ((i < sizeof(limb)) && (((unsigned char *)&limb)[i] == i))
+		i++;
+	return (i == sizeof(limb));
+}
+
+/* AUI_LITTLE or AUI_BIG if count words of size bytes form a byte string in that order, otherwise 0 */
+static int layout(size_t count, size_t size, int order, int endian)
+{
+	if (size == 1)
+		return order;
+	if ((count == 1) || (order == endian))
+		return endian;
+	return 0;
+}
+
+AUI_TYPE aui_msbn(AUI_TYPE native)
+{
+	assert(native);
+#ifdef BUILTIN_MSBN
+	return BUILTIN_MSBN(native);
+#else
+	native |= native >> 1;
+	native |= native >> 2;
+	native |= native >> 4;
+#if (AUI_TYPE_BIT >= 16)
+	native |= native >> 8;
+#if (AUI_TYPE_BIT >= 32)
+	native |= native >> 16;
+#if (AUI_TYPE_BIT >= 64)
+	native |= native >> 32;
+#endif
+#endif
+#endif
+	return most[(AUI_TYPE)(native * DEBRUIJN) >> SHIFT];
+#endif
+}
+
+AUI_TYPE aui_lsbn(AUI_TYPE native)
+{
+	assert(native);
+#ifdef BUILTIN_LSBN
+	return BUILTIN_LSBN(native);
+#else
+	return least[(AUI_TYPE)((native & (-native)) * DEBRUIJN) >> SHIFT];
+#endif
+}
+
+size_t aui_msba(const struct aui *x)
+{
+	size_t i;
+
+	assert(x);
+	if ((i = highest(x->array, x->length)))
+		return (AUI_TYPE_BIT * (i - 1) + aui_msbn(x->array[i - 1]));
+	return AUI_NONE;
+}
+
+size_t aui_lsba(const struct aui *x)
+{
+	size_t i;
+
+	assert(x);
+	if ((i = lowest(x->array, x->length)) < x->length)
+		return (AUI_TYPE_BIT * i + aui_lsbn(x->array[i]));
+	return AUI_NONE;
+}
+
+size_t aui_nextbit(const struct aui *x, size_t from)
+{
+	size_t i;
+	AUI_TYPE binary;
+
+	assert(x);
+	if ((i = from / AUI_TYPE_BIT) >= x->length)
+		return AUI_NONE;
+	if ((binary = x->array[i] & (AUI_TYPE)(AUI_TYPE_MAX << (from % AUI_TYPE_BIT))))
+		return (AUI_TYPE_BIT * i + aui_lsbn(binary));
+	i++;
+	if ((i += lowest(x->array + i, x->length - i)) < x->length)
+		return (AUI_TYPE_BIT * i + aui_lsbn(x->array[i]));
+	return AUI_NONE;
+}
+
+size_t aui_prevbit(const struct aui *x, size_t from)
+{
+	size_t i;
+	AUI_TYPE binary;
+
+	assert(x);
+	if ((i = from / AUI_TYPE_BIT) >= x->length)
+		return aui_msba(x);
+	if ((binary = x->array[i] & (AUI_TYPE)(AUI_TYPE_MAX >> (AUI_TYPE_BIT - 1 - from % AUI_TYPE_BIT))))
+		return (AUI_TYPE_BIT * i + aui_msbn(binary));
+	if ((i = highest(x->array, i)))
+		return (AUI_TYPE_BIT * (i - 1) + aui_msbn(x->array[i - 1]));
+	return AUI_NONE;
+}
+
+size_t aui_listbits(const struct aui *x, size_t from, size_t *bits, size_t size)
+{
+	size_t i;
+	size_t count;
+	AUI_TYPE binary;
+
+	assert(x);
+	assert(bits || !size);
+	if ((i = from / AUI_TYPE_BIT) >= x->length)
+		return 0;
+	binary = x->array[i] & (AUI_TYPE)(AUI_TYPE_MAX << (from % AUI_TYPE_BIT));
+	count = 0;
+	while (count < size) {
+		if (!binary) {
+			i++;
+			if ((i += lowest(x->array + i, x->length - i)) >= x->length)
+				break;
+			binary = x->array[i];
+		}
+		bits[count++] = AUI_TYPE_BIT * i + aui_lsbn(binary);
+		binary &= binary - 1;
+	}
+	return count;
+}
+
+size_t aui_popcount(const struct aui *x)
+{
+	assert(x);
+	return popcount(x->array, NULL, x->length);
+}
+
+size_t aui_hamming(const struct aui *x, const struct aui *y)
+{
+	assert(x);
+	assert(y);
+	if (x->length > y->length)
+		return popcount(x->array, y->array, y->length)
+			+ popcount(x->array + y->length, NULL, x->length - y->length);
+	return popcount(x->array, y->array, x->length)
+		+ popcount(y->array + x->length, NULL, y->length - x->length);
+}
+
+void aui_hash_init(struct aui_hash_state *state, unsigned long seed)
+{
+	assert(state);
+	hash_start(state->acc, state->key, seed);
+	state->seed = seed;
+	state->fill = 0;
+	state->stripes = 0;
+	state->total = 0;
+	state->zeros = 0;
+	return;
+}
+
+void aui_hash_update(struct aui_hash_state *state, const struct aui *x)
+{
+	static const unsigned char zero[64];
+	size_t length;
+	size_t size;
+
+	assert(state);
+	assert(x);
+	if (!(length = highest(x->array, x->length))) {
+		state->zeros += x->length;
+		return;
+	}
+	/* zero limbs count only once something more significant follows */
+	size = state->zeros * sizeof(*x->array);
+	while (size) {
+		hash_feed(state, zero, (size < sizeof(zero)) ? size : sizeof(zero));
+		size -= (size < sizeof(zero)) ? size : sizeof(zero);
+	}
+	hash_feed(state, (const unsigned char *)x->array, length * sizeof(*x->array));
+	state->zeros = x->length - length;
+	return;
+}
+
+unsigned long aui_hash_final(const struct aui_hash_state *state)
+{
+	unsigned long acc[8];
+	unsigned long key[8];
+
+	assert(state);
+	memcpy(acc, state->acc, sizeof(acc));
+	memcpy(key, state->key, sizeof(key));
+	return hash_end(acc, key, (const unsigned char *)state->buffer, state->fill, state->seed, state->total);
+}
+
+unsigned long aui_hash(const struct aui *x, unsigned long seed)
+{
+	const unsigned char *data;
+	unsigned long acc[8];
+	unsigned long key[8];
+	size_t size;
+	size_t stripes;
+
+	assert(x);
+	data = (const unsigned char *)x->array;
+	size = highest(x->array, x->length) * sizeof(*x->array);
+	stripes = size / HASH_STRIPE;
+	hash_start(acc, key, seed);
+	hash_run(acc, key, 0, data, stripes);
+	return hash_end(acc, key, data + stripes * HASH_STRIPE, size - stripes * HASH_STRIPE, seed, size);
+}
+
+int aui_testbit(const struct aui *x, size_t bit)
+{
+	assert(x);
+	if (bit / AUI_TYPE_BIT >= x->length)
+		return 0;
+	return (x->array[bit / AUI_TYPE_BIT] >> (bit % AUI_TYPE_BIT)) & 1;
+}
+
+void aui_setbit(struct aui *x, size_t bit)
+{
+	assert(x);
+	if (bit / AUI_TYPE_BIT < x->length)
+		x->array[bit / AUI_TYPE_BIT] |= (AUI_TYPE)1 << (bit % AUI_TYPE_BIT);
+	return;
+}
+
+void aui_clrbit(struct aui *x, size_t bit)
+{
+	assert(x);
+	if (bit / AUI_TYPE_BIT < x->length)
+		x->array[bit / AUI_TYPE_BIT] &= ~((AUI_TYPE)1 << (bit % AUI_TYPE_BIT));
+	return;
+}
+
+void aui_flipbit(struct aui *x, size_t bit)
+{
+	assert(x);
+	if (bit / AUI_TYPE_BIT < x->length)
+		x->array[bit / AUI_TYPE_BIT] ^= (AUI_TYPE)1 << (bit % AUI_TYPE_BIT);
+	return;
+}
+
+unsigned long aui_getbits(const struct aui *x, size_t bit, unsigned int count)
+{
+	size_t i;
+	unsigned int offset;
+	unsigned int shift;
+	unsigned long value;
+
+	assert(x);
+	assert(count <= sizeof(unsigned long) * CHAR_BIT);
+	i = bit / AUI_TYPE_BIT;
+	offset = bit % AUI_TYPE_BIT;
+	shift = 0;
+	value = 0;
+	while ((shift < count) && (i < x->length)) {
+		value |= (unsigned long)(AUI_TYPE)(x->array[i++] >> offset) << shift;
+		shift += AUI_TYPE_BIT - offset;
+		offset = 0;
+	}
+	if (count < sizeof(unsigned long) * CHAR_BIT)
+		value &= (1UL << count) - 1;
+	return value;
+}
+
+void aui_setbits(struct aui *x, size_t bit, unsigned int count, unsigned long value)
+{
+	size_t i;
+	unsigned int offset;
+	unsigned int shift;
+	unsigned long mask;
+	AUI_TYPE bits;
+
+	assert(x);
+	assert(count <= sizeof(unsigned long) * CHAR_BIT);
+	mask = (count < sizeof(unsigned long) * CHAR_BIT) ? (1UL << count) - 1 : ULONG_MAX;
+	value &= mask;
+	i = bit / AUI_TYPE_BIT;
+	offset = bit % AUI_TYPE_BIT;
+	shift = 0;
+	while ((shift < count) && (i < x->length)) {
+		bits = (AUI_TYPE)((AUI_TYPE)(mask >> shift) << offset);
+		x->array[i] &= ~bits;
+		x->array[i++] |= (AUI_TYPE)((AUI_TYPE)(value >> shift) << offset);
+		shift += AUI_TYPE_BIT - offset;
+		offset = 0;
+	}
+	return;
+}
+
+/* limbs per rank/select block, 512 bits */
+#define INDEX_BLOCK (512 / AUI_TYPE_BIT)
+
+struct aui_index *aui_index_alloc(const struct aui *x)
+{
+	struct aui_index *index;
+
+	assert(x);
+	if (!(index = malloc(sizeof(*index))))
+		return NULL;
+	index->x = x;
+	index->blocks = x->length / INDEX_BLOCK + !!(x->length % INDEX_BLOCK);
+	if (!(index->count = malloc(sizeof(*index->count) * (index->blocks + 1)))) {
+		free(index);
+		return NULL;
+	}
+	aui_index_build(index);
+	return index;
+}
+
+void aui_index_free(struct aui_index *index)
+{
+	assert(index);
+	free(index->count);
+	free(index);
+	return;
+}
+
+void aui_index_build(struct aui_index *index)
+{
+	size_t i;
+	size_t n;
+
+	assert(index);
+	assert(index->blocks == index->x->length / INDEX_BLOCK + !!(index->x->length % INDEX_BLOCK));
+	index->count[0] = 0;
+	i = 0;
+	while (i < index->blocks) {
+		n = (i < index->x->length / INDEX_BLOCK) ? INDEX_BLOCK : index->x->length % INDEX_BLOCK;
+		index->count[i + 1] = index->count[i] + popcount(index->x->array + i * INDEX_BLOCK, NULL, n);
+		i++;
+	}
+	return;
+}
+
+size_t aui_rank(const struct aui_index *index, size_t bit)
+{
+	size_t i;
+	size_t j;
+	AUI_TYPE binary;
+
+	assert(index);
+	if ((i = bit / AUI_TYPE_BIT) >= index->x->length)
+		return index->count[index->blocks];
+	j = i - i % INDEX_BLOCK;
+	binary = index->x->array[i] & (((AUI_TYPE)1 << (bit % AUI_TYPE_BIT)) - 1);
+	return index->count[i / INDEX_BLOCK] + popcount(index->x->array + j, NULL, i - j)
+		+ popcount(&binary, NULL, 1);
+}
+
+size_t aui_select(const struct aui_index *index, size_t k)
+{
+	size_t low;
+	size_t high;
+	size_t middle;
+	size_t i;
+	size_t count;
+	AUI_TYPE binary;
+
+	assert(index);
+	if (k >= index->count[index->blocks])
+		return AUI_NONE;
+	low = 0;
+	high = index->blocks;
+	while ((high - low) > 1) {
+		middle = low + (high - low) / 2;
+		if (index->count[middle] <= k)
+			low = middle;
+		else
+			high = middle;
+	}
+	k -= index->count[low];
+	i = low * INDEX_BLOCK;
+	while ((count = popcount(index->x->array + i, NULL, 1)) <= k) {
+		k -= count;
+		i++;
+	}
+	binary = index->x->array[i];
+	while (k--)
+		binary &= binary - 1;
+	return AUI_TYPE_BIT * i + aui_lsbn(binary);
+}
+
+struct aui *aui_alloc(size_t length)
+{
+	struct aui *x;
+
+	assert(length);
+	if (length > AUI_LENGTH_MAX)
+		return NULL;
+	if (!(x = malloc(sizeof(*x))))
+		return NULL;
+	if (!(x->array = malloc(sizeof(*x->array) * length))) {
+		free(x);
+		return NULL;
+	}
+	x->length = length;
+	x->view = 0;
+	return x;
+}
+
+struct aui *aui_view(const AUI_TYPE *array, size_t length)
+{
+	struct aui *x;
+
+	assert(array);
+	assert(length);
+	if (length > AUI_LENGTH_MAX)
+		return NULL;
+	if (!(x = malloc(sizeof(*x))))
+		return NULL;
+	x->array = (AUI_TYPE *)array;
+	x->length = length;
+	x->next = NULL;
+	x->view = 1;
+	return x;
+}
+
+void aui_free(struct aui *x)
+{
+	assert(x);
+	if (!x->view)
+		free(x->array);
+	free(x);
+	return;
+}
+
+struct aui *aui_pull(size_t length)
+{
+	struct aui *x;
+	struct aui *y;
+
+	assert(length);
+	x = list;
+	while (x && (x->length > length)) {
+		y = x;
+		x = x->next;
+	}
+	if (x && (x->length == length)) {
+		if (x == list)
+			list = list->next;
+		else
+			y->next = x->next;
+		return x;
+	}
+	return aui_alloc(length);
+}
+
+void aui_push(struct aui *x)
+{
+	struct aui *y;
+
+	assert(x);
+	/* a view can't be handed out again, its array isn't ours */
+	if (x->view) {
+		free(x);
+		return;
+	}
+	x->next = list;
+	while (x->next && (x->next->length > x->length)) {
+		y = x->next;
+		x->next = x->next->next;
+	}
+	if (x->next == list)
+		list = x;
+	else
+		y->next = x;
+	return;
+}
+
+void aui_wipe(void)
+{
+	struct aui *x;
+
+	while ((x = list)) {
+		list = list->next;
+		aui_free(x);
+	}
+	return;
+}
+
+void aui_seti(struct aui *x, unsigned long value)
+{
+	size_t i;
+
+	assert(x);
+	i = x->length;
+	while (i > (sizeof(value) / sizeof(*x->array)))
+		x->array[--i] = 0;
+	while (i--)
+		x->array[i] = value >> (AUI_TYPE_BIT * i);
+	return;
+}
+
+/*
+ * Radix conversion splits a number at a power of the base and converts
+ * the two halves independently; big is the largest power of the base that
+ * fits in a limb, holding digits digits, and power[j] is big^(2^j), the
+ * table being computed once per conversion and shared by all the halves.
+ */
+#define RADIX_LEVELS (sizeof(size_t) * CHAR_BIT)
+#ifndef AUI_RADIX_THRESHOLD
+#define AUI_RADIX_THRESHOLD AUI_SIZTOLEN(256)
+#endif
+
+struct radix {
+	const char *set;
+	AUI_TYPE base;
+	AUI_TYPE big;
+	size_t digits;
+	signed char value[UCHAR_MAX + 1];
+	AUI_TYPE *power[RADIX_LEVELS];
+	size_t length[RADIX_LEVELS];
+	size_t levels;
+};
+
+/* r = x * y, truncated to n limbs, on up to count threads */
+static void product(AUI_TYPE *r, const AUI_TYPE *x, size_t n, const AUI_TYPE *y, size_t m, unsigned int count)
+{
+#ifdef AUI_THREADS
+	if ((count > 1) && (n >= AUI_THREADS_THRESHOLD) && (m >= AUI_THREADS_THRESHOLD)
+		&& mul_threads(r, x, n, y, m, count))
+		return;
+#else
+	(void)count;
+#endif
+	mul(r, x, n, y, m);
+	return;
+}
+
+static void radix_free(struct radix *radix)
+{
+	while (radix->levels--)
+		free(radix->power[radix->levels]);
+	return;
+}
+
+static void radix_init(struct radix *radix, const char *set, int base)
+{
+	int i;
+
+	radix->set = set;
+	radix->base = base;
+	radix->big = base;
+	radix->digits = 1;
+	while (radix->big <= (AUI_TYPE_MAX / radix->base)) {
+		radix->big *= radix->base;
+		radix->digits++;
+	}
+	memset(radix->value, -1, sizeof(radix->value));
+	i = 0;
+	while (i < base) {
+		radix->value[(unsigned char)set[i]] = i;
+		i++;
+	}
+	radix->levels = 0;
+	return;
+}
+
+/* computes the powers needed for numbers of up to chunks times digits digits */
+static int radix_powers(struct radix *radix, size_t chunks, unsigned int count)
+{
+	AUI_TYPE *square;
+	size_t length;
+
+	if (!(radix->power[0] = malloc(sizeof(*radix->power[0]))))
+		return 0;
+	radix->power[0][0] = radix->big;
+	radix->length[0] = 1;
+	radix->levels = 1;
+	/* resolve the dispatched kernels before any threads use them */
+	mul_1(radix->power[0], radix->power[0], 0, 0, 0);
+	addmul_1(radix->power[0], radix->power[0], 0, 0);
+	while ((radix->levels < RADIX_LEVELS) && (((size_t)1 << radix->levels) < chunks)) {
+		length = radix->length[radix->levels - 1] * 2;
+		if (!(square = calloc(length * 2, sizeof(*square)))) {
+			radix_free(radix);
+			return 0;
+		}
+		memcpy(square + length, radix->power[radix->levels - 1], sizeof(*square) * (length / 2));
+		product(square, square + length, length, radix->power[radix->levels - 1], length / 2, count);
+		while (!square[length - 1])
+			length--;
+		radix->power[radix->levels] = square;
+		radix->length[radix->levels] = length;
+		radix->levels++;
+	}
+	return 1;
+}
+
+struct radix_job {
+	const struct radix *radix;
+	AUI_TYPE *x;
+	size_t n;
+	char *string;
+	const char *digits;
+	size_t size;
+	unsigned int count;
+	int result;
+};
+
+static int radix_gets(const struct radix *radix, char *string, AUI_TYPE *x, size_t n, size_t chunks, unsigned int count);
+static int radix_sets(const struct radix *radix, AUI_TYPE *x, const char *string, size_t size, unsigned int count);
+
+static void *radix_gets_job(void *argument)
+{
+	struct radix_job *job;
+
+	job = argument;
+	job->result = radix_gets(job->radix, job->string, job->x, job->n, job->size, job->count);
+	return NULL;
+}
+
+static void *radix_sets_job(void *argument)
+{
+	struct radix_job *job;
+
+	job = argument;
+	job->result = radix_sets(job->radix, job->x, job->digits, job->size, job->count);
+	return NULL;
+}
+
+/* runs the two jobs, on two threads if split */
+static void halves(void *(*function)(void *), struct radix_job *job, int split)
+{
+	if (!split) {
+		function(&job[0]);
+		function(&job[1]);
+		return;
+	}
+#ifdef AUI_THREADS
+	parallel(function, job, sizeof(*job), 2);
+#endif
+	return;
+}
+
+/*
+ * Writes exactly chunks times digits digits of x (n limbs, destroyed) to
+ * string; x must be less than big^chunks.
+ */
+static int radix_gets(const struct radix *radix, char *string, AUI_TYPE *x, size_t n, size_t chunks, unsigned int count)
+{
+	struct radix_job job[2];
+	AUI_TYPE *buffer;
+	AUI_TYPE remainder;
+	size_t low;
+	size_t m;
+	size_t i;
+	size_t j;
+	int split;
+	int result;
+
+	while (n && !x[n - 1])
+		n--;
+	if ((n <= AUI_RADIX_THRESHOLD) || (chunks <= 2)) {
+		i = chunks * radix->digits;
+		while (chunks--) {
+			remainder = 0;
+			if (n) {
+				remainder = divmod_1(x, x, n, radix->big);
+				n -= !x[n - 1];
+			}
+			j = radix->digits;
+			while (j--) {
+				string[--i] = radix->set[remainder % radix->base];
+				remainder /= radix->base;
+			}
+		}
+		return 1;
+	}
+	j = 1;
+	while (((size_t)1 << (j + 1)) < chunks)
+		j++;
+	low = (size_t)1 << j;
+	m = radix->length[j];
+	if (n < m) {
+		memset(string, radix->set[0], (chunks - low) * radix->digits);
+		return radix_gets(radix, string + (chunks - low) * radix->digits, x, n, low, count);
+	}
+	if (!(buffer = malloc(sizeof(*buffer) * (n + 1))))
+		return 0;
+	result = 0;
+	if (!divmod_n(buffer + m, buffer, x, n, radix->power[j], m))
+		goto free_buffer;
+	split = 0;
+#ifdef AUI_THREADS
+	split = (count > 1) && (n >= AUI_THREADS_THRESHOLD);
+#endif
+	job[0].radix = radix;
+	job[0].x = buffer + m;
+	job[0].n = n - m + 1;
+	job[0].string = string;
+	job[0].size = chunks - low;
+	job[0].count = split ? count - count / 2 : count;
+	job[1].radix = radix;
+	job[1].x = buffer;
+	job[1].n = m;
+	job[1].string = string + (chunks - low) * radix->digits;
+	job[1].size = low;
+	job[1].count = split ? count / 2 : count;
+	halves(radix_gets_job, job, split);
+	result = job[0].result && job[1].result;
+free_buffer:
+	free(buffer);
+	return result;
+}
+
+/* x = the value of the size digits of string, in as many limbs as chunks */
+static int radix_sets(const struct radix *radix, AUI_TYPE *x, const char *string, size_t size, unsigned int count)
+{
+	struct radix_job job[2];
+	AUI_TYPE *buffer;
+	AUI_TYPE value;
+	AUI_TYPE factor;
+	AUI_TYPE carry;
+	size_t chunks;
+	size_t low;
+	size_t n;
+	size_t i;
+	size_t j;
+	int split;
+	int result;
+
+	chunks = (size + radix->digits - 1) / radix->digits;
+	if ((chunks <= AUI_RADIX_THRESHOLD) || (chunks <= 2)) {
+		memset(x, 0, sizeof(*x) * chunks);
+		n = 0;
+		i = 0;
+		while (i < size) {
+			j = (size - i) % radix->digits;
+			j = j ? j : radix->digits;
+			value = 0;
+			factor = 1;
+			while (j--) {
+				value = value * radix->base + radix->value[(unsigned char)string[i++]];
+				factor *= radix->base;
+			}
+			if ((carry = mul_1(x, x, n, factor, value)))
+				x[n++] = carry;
+		}
+		return 1;
+	}
+	j = 1;
+	while (((size_t)1 << (j + 1)) < chunks)
+		j++;
+	low = (size_t)1 << j;
+	if (!(buffer = malloc(sizeof(*buffer) * (chunks + low))))
+		return 0;
+	n = size - low * radix->digits;
+	split = 0;
+#ifdef AUI_THREADS
+	split = (count > 1) && (chunks >= AUI_THREADS_THRESHOLD);
+#endif
+	job[0].radix = radix;
+	job[0].x = buffer;
+	job[0].digits = string;
+	job[0].size = n;
+	job[0].count = split ? count - count / 2 : count;
+	job[1].radix = radix;
+	job[1].x = buffer + chunks;
+	job[1].digits = string + n;
+	job[1].size = size - n;
+	job[1].count = split ? count / 2 : count;
+	halves(radix_sets_job, job, split);
+	result = job[0].result && job[1].result;
+	if (result) {
+		memset(buffer + (chunks - low), 0, sizeof(*buffer) * low);
+		product(x, buffer, chunks, radix->power[j], radix->length[j], count);
+		carry = add_n(x, x, buffer + chunks, low, 0);
+		add_1(x + low, x + low, chunks - low, carry);
+	}
+	free(buffer);
+	return result;
+}
+
+int aui_sets(struct aui *x, const char *string, const char *set, int base)
+{
+	struct radix radix;
+	AUI_TYPE *buffer;
+	unsigned int count;
+	size_t chunks;
+	size_t size;
+	int result;
+
+	assert(x);
+	assert(string);
+	assert(set);
+	assert(base >= 2);
+	assert(base <= CHAR_MAX);
+	radix_init(&radix, set, base);
+	size = 0;
+	while (radix.value[(unsigned char)string[size]] >= 0)
+		size++;
+	if (!size) {
+		aui_seti(x, 0);
+		return 1;
+	}
+	count = 1;
+#ifdef AUI_THREADS
+	count = threads;
+#endif
+	chunks = (size + radix.digits - 1) / radix.digits;
+	if (!radix_powers(&radix, chunks, count))
+		return 0;
+	result = 0;
+	if (!(buffer = malloc(sizeof(*buffer) * chunks)))
+		goto free_radix;
+	if (!radix_sets(&radix, buffer, string, size, count))
+		goto free_buffer;
+	chunks = (chunks < x->length) ? chunks : x->length;
+	memcpy(x->array, buffer, sizeof(*buffer) * chunks);
+	memset(x->array + chunks, 0, sizeof(*buffer) * (x->length - chunks));
+	result = 1;
+free_buffer:
+	free(buffer);
+free_radix:
+	radix_free(&radix);
+	return result;
+}
+
+void aui_import(struct aui *x, const void *data, size_t count, size_t size, int order, int endian)
+{
+	const unsigned char *p;
+	const unsigned char *word;
+	size_t total;
+	size_t bytes;
+	size_t b;
+	size_t i;
+	size_t j;
+
+	assert(x);
+	assert(data || !count || !size);
+	assert((order == AUI_BIG) || (order == AUI_LITTLE));
+	assert((endian == AUI_BIG) || (endian == AUI_LITTLE) || (endian == AUI_NATIVE));
+	p = data;
+	if (!endian)
+		endian = little() ? AUI_LITTLE : AUI_BIG;
+	total = count * size;
+	bytes = sizeof(*x->array) * x->length;
+	bytes = (total < bytes) ? total : bytes;
+	memset((unsigned char *)x->array + bytes, 0, sizeof(*x->array) * x->length - bytes);
+	if (little() && (layout(count, size, order, endian) == AUI_LITTLE)) {
+		memcpy(x->array, p, bytes);
+		return;
+	}
+	if (little() && (layout(count, size, order, endian) == AUI_BIG)) {
+		reverse((unsigned char *)x->array, p + total - bytes, bytes);
+		return;
+	}
+	memset(x->array, 0, bytes);
+	b = 0;
+	i = 0;
+	while (b < bytes) {
+		word = p + ((order == AUI_BIG) ? (count - 1 - i) : i) * size;
+		j = 0;
+		while ((j < size) && (b < bytes)) {
+			x->array[b / sizeof(*x->array)] |= (AUI_TYPE)word[(endian == AUI_BIG) ? (size - 1 - j) : j]
+				<< (b % sizeof(*x->array) * CHAR_BIT);
+			b++;
+			j++;
+		}
+		i++;
+	}
+	return;
+}
+
+unsigned long aui_geti(const struct aui *x)
+{
+	unsigned long value;
+	size_t i;
+
+	assert(x);
+	value = 0;
+	i = sizeof(value) / sizeof(*x->array);
+	i = (x->length < i) ? x->length : i;
+	while (i--)
+		value |= (unsigned long)x->array[i] << (AUI_TYPE_BIT * i);
+	return value;
+}
+
+size_t aui_export(void *data, size_t count, size_t size, int order, int endian, const struct aui *x)
+{
+	unsigned char *p;
+	unsigned char *word;
+	size_t total;
+	size_t bytes;
+	size_t b;
+	size_t i;
+	size_t j;
+
+	assert(data || !count);
+	assert(size);
+	assert((order == AUI_BIG) || (order == AUI_LITTLE));
+	assert((endian == AUI_BIG) || (endian == AUI_LITTLE) || (endian == AUI_NATIVE));
+	assert(x);
+	p = data;
+	if (!endian)
+		endian = little() ? AUI_LITTLE : AUI_BIG;
+	total = count * size;
+	bytes = sizeof(*x->array) * x->length;
+	bytes = (total < bytes) ? total : bytes;
+	if (little() && (layout(count, size, order, endian) == AUI_LITTLE)) {
+		memcpy(p, x->array, bytes);
+		memset(p + bytes, 0, total - bytes);
+	} else if (little() && (layout(count, size, order, endian) == AUI_BIG)) {
+		reverse(p + total - bytes, (const unsigned char *)x->array, bytes);
+		memset(p, 0, total - bytes);
+	} else {
+		memset(p, 0, total);
+		b = 0;
+		i = 0;
+		while (b < bytes) {
+			word = p + ((order == AUI_BIG) ? (count - 1 - i) : i) * size;
+			j = 0;
+			while ((j < size) && (b < bytes)) {
+				word[(endian == AUI_BIG) ? (size - 1 - j) : j]
+					= (unsigned char)(x->array[b / sizeof(*x->array)] >> (b % sizeof(*x->array) * CHAR_BIT));
+				b++;
+				j++;
+			}
+			i++;
+		}
+	}
+	/* the number of words needed, whether or not count was enough */
+	if ((b = aui_msba(x)) == AUI_NONE)
+		return 0;
+	return b / CHAR_BIT / size + 1;
+}
+
+int aui_gets(char *string, size_t size, const char *set, int base, const struct aui *x)
+{
+	struct radix radix;
+	AUI_TYPE *buffer;
+	char *digits;
+	unsigned int count;
+	size_t chunks;
+	size_t length;
+	size_t bits;
+	size_t i;
+	int result;
+
+	assert(string);
+	assert(size);
+	assert(set);
+	assert(base >= 2);
+	assert(base <= CHAR_MAX);
+	assert(x);
+	if ((bits = aui_msba(x)) == AUI_NONE) {
+		string[0] = '\0';
+		return 1;
+	}
+	bits++;
+	radix_init(&radix, set, base);
+	count = 1;
+#ifdef AUI_THREADS
+	count = threads;
+#endif
+	/* big^chunks > 2^bits > x */
+	chunks = bits / aui_msbn(radix.big) + 1;
+	if (!radix_powers(&radix, chunks, count))
+		return 0;
+	result = 0;
+	length = (bits + AUI_TYPE_BIT - 1) / AUI_TYPE_BIT;
+	if (!(buffer = malloc(sizeof(*buffer) * length)))
+		goto free_radix;
+	if (!(digits = malloc(chunks * radix.digits)))
+		goto free_buffer;
+	memcpy(buffer, x->array, sizeof(*buffer) * length);
+	if (!radix_gets(&radix, digits, buffer, length, chunks, count))
+		goto free_digits;
+	length = chunks * radix.digits;
+	i = 0;
+	while (((i + 1) < length) && (digits[i] == set[0]))
+		i++;
+	if ((length - i) < size) {
+		memcpy(string, digits + i, length - i);
+		string[length - i] = '\0';
+		result = 1;
+	}
+free_digits:
+	free(digits);
+free_buffer:
+	free(buffer);
+free_radix:
+	radix_free(&radix);
+	return result;
+}
+
+void aui_asgn(struct aui *x, const struct aui *y)
+{
+	size_t i;
+
+	assert(x);
+	assert(y);
+	i = x->length;
+	while (i > y->length)
+		x->array[--i] = 0;
+	while (i--)
+		x->array[i] = y->array[i];
+	return;
+}
+
+void aui_swap(struct aui *x, struct aui *y)
+{
+	size_t i;
+	AUI_TYPE *array;
+	AUI_TYPE binary;
+
+	assert(x);
+	assert(y);
+	/* the arrays of views stay put */
+	if ((x->length == y->length) && !x->view && !y->view) {
+		array = x->array;
+		x->array = y->array;
+		y->array = array;
+		return;
+	}
+	i = (x->length > y->length) ? x->length : y->length;
+	while (i > y->length)
+		x->array[--i] = 0;
+	while (i > x->length)
+		y->array[--i] = 0;
+	while (i--) {
+		binary = x->array[i];
+		x->array[i] = y->array[i];
+		y->array[i] = binary;
+	}
+	return;
+}
+
+int aui_eq(const struct aui *x, const struct aui *y)
+{
+	assert(x);
+	assert(y);
+	if (x->length > y->length)
+		return !highest(x->array + y->length, x->length - y->length)
+			&& !differ(x->array, y->array, y->length);
+	return !highest(y->array + x->length, y->length - x->length)
+		&& !differ(x->array, y->array, x->length);
+}
+
+int aui_neq(const struct aui *x, const struct aui *y)
+{
+	assert(x);
+	assert(y);
+	return !aui_eq(x, y);
+}
+
+int aui_lt(const struct aui *x, const struct aui *y)
+{
+	size_t i;
+
+	assert(x);
+	assert(y);
+	i = (x->length < y->length) ? x->length : y->length;
+	if (highest(x->array + i, x->length - i))
+		return 0;
+	if (highest(y->array + i, y->length - i))
+		return 1;
+	if ((i = differ(x->array, y->array, i)))
+		return (x->array[i - 1] < y->array[i - 1]);
+	return 0;
+}
+
+int aui_lte(const struct aui *x, const struct aui *y)
+{
+	assert(x);
+	assert(y);
+	return !aui_gt(x, y);
+}
+
+int aui_gt(const struct aui *x, const struct aui *y)
+{
+	size_t i;
+
+	assert(x);
+	assert(y);
+	i = (x->length < y->length) ? x->length : y->length;
+	if (highest(x->array + i, x->length - i))
+		return 1;
+	if (highest(y->array + i, y->length - i))
+		return 0;
+	if ((i = differ(x->array, y->array, i)))
+		return (x->array[i - 1] > y->array[i - 1]);
+	return 0;
+}
+
+int aui_gte(const struct aui *x, const struct aui *y)
+{
+	assert(x);
+	assert(y);
+	return !aui_lt(x, y);
+}
+
+int aui_cmp(const struct aui *x, const struct aui *y)
+{
+	size_t n;
+	size_t m;
+
+	assert(x);
+	assert(y);
+	n = highest(x->array, x->length);
+	m = highest(y->array, y->length);
+	if (n != m)
+		return (n < m) ? -1 : 1;
+	if (!(n = differ(x->array, y->array, n)))
+		return 0;
+	return (x->array[n - 1] < y->array[n - 1]) ? -1 : 1;
+}
+
+/*
+ * aui_sort() is an MSD radix sort on the bytes of the limbs, every integer
+ * zero-extended to the longest significant length in its range. Ranges of
+ * fewer than SORT_SMALL integers are insertion sorted. The pending ranges
+ * are disjoint and hold at least two integers each, so the stack never
+ * holds more than count / 2 of them.
+ */
+#define SORT_SMALL 16
+
+struct sort_key {
+	struct aui *x;
+	size_t n;
+};
+
+struct sort_range {
+	size_t start;
+	size_t end;
+	size_t bytes;
+};
+
+static int sort_cmp(const struct sort_key *x, const struct sort_key *y)
+{
+	size_t i;
+
+	if (x->n != y->n)
+		return (x->n < y->n) ? -1 : 1;
+	if (!(i = differ(x->x->array, y->x->array, x->n)))
+		return 0;
+	return (x->x->array[i - 1] < y->x->array[i - 1]) ? -1 : 1;
+}
+
+static unsigned int sort_byte(const struct sort_key *key, size_t byte)
+{
+	size_t i;
+
+	i = byte / sizeof(AUI_TYPE);
+	if (i >= key->n)
+		return 0;
+	return (unsigned int)(key->x->array[i] >> (byte % sizeof(AUI_TYPE) * CHAR_BIT)) & UCHAR_MAX;
+}
+
+int aui_sort(struct aui **x, size_t count)
+{
+	struct sort_key *keys;
+	struct sort_key *buffer;
+	struct sort_key key;
+	struct sort_range *stack;
+	size_t counts[UCHAR_MAX + 1];
+	size_t start;
+	size_t end;
+	size_t bytes;
+	size_t length;
+	size_t top;
+	size_t i;
+	size_t j;
+	int result;
+
+	assert(x || !count);
+	if (count < 2)
+		return 1;
+	result = 0;
+	if (!(keys = malloc(sizeof(*keys) * count)))
+		return 0;
+	if (!(buffer = malloc(sizeof(*buffer) * count)))
+		goto free_keys;
+	if (!(stack = malloc(sizeof(*stack) * (count / 2 + 1))))
+		goto free_buffer;
+	i = 0;
+	while (i < count) {
+		assert(x[i]);
+		keys[i].x = x[i];
+		keys[i].n = highest(x[i]->array, x[i]->length);
+		i++;
+	}
+	stack[0].start = 0;
+	stack[0].end = count;
+	stack[0].bytes = (size_t)-1;
+	top = 1;
+	while (top) {
+		top--;
+		start = stack[top].start;
+		end = stack[top].end;
+		bytes = stack[top].bytes;
+		while ((end - start) > 1) {
+			if ((end - start) < SORT_SMALL) {
+				i = start + 1;
+				while (i < end) {
+					key = keys[i];
+					j = i;
+					while ((j > start) && (sort_cmp(&key, &keys[j - 1]) < 0)) {
+						keys[j] = keys[j - 1];
+						j--;
+					}
+					keys[j] = key;
+					i++;
+				}
+				break;
+			}
+			/* skip the bytes above the longest integer in the range */
+			length = 0;
+			i = start;
+			while (i < end) {
+				if (keys[i].n > length)
+					length = keys[i].n;
+				i++;
+			}
+			if (bytes > (length * sizeof(AUI_TYPE)))
+				bytes = length * sizeof(AUI_TYPE);
+			if (!bytes)
+				break;
+			bytes--;
+			memset(counts, 0, sizeof(counts));
+			i = start;
+			while (i < end) {
+				counts[sort_byte(&keys[i], bytes)]++;
+				i++;
+			}
+			if (counts[sort_byte(&keys[start], bytes)] == (end - start))
+				continue;
+			j = start;
+			i = 0;
+			while (i <= UCHAR_MAX) {
+				length = counts[i];
+				counts[i] = j;
+				j += length;
+				i++;
+			}
+			i = start;
+			while (i < end) {
+				buffer[counts[sort_byte(&keys[i], bytes)]++] = keys[i];
+				i++;
+			}
+			memcpy(keys + start, buffer + start, sizeof(*keys) * (end - start));
+			/* counts[i] is now the end of bucket i */
+			j = start;
+			i = 0;
+			while (i <= UCHAR_MAX) {
+				if ((counts[i] - j) > 1) {
+					stack[top].start = j;
+					stack[top].end = counts[i];
+					stack[top].bytes = bytes;
+					top++;
+				}
+				j = counts[i];
+				i++;
+			}
+			break;
+		}
+	}
+	i = 0;
+	while (i < count) {
+		x[i] = keys[i].x;
+		i++;
+	}
+	result = 1;
+	free(stack);
+free_buffer:
+	free(buffer);
+free_keys:
+	free(keys);
+	return result;
+}
+
+int aui_eval(const struct aui *x)
+{
+	assert(x);
+	return (lowest(x->array, x->length) < x->length);
+}
+
+void aui_one(struct aui *x)
+{
+	assert(x);
+	bitwise(x->array, x->array, x->array, x->length, ONE);
+	return;
+}
+
+void aui_two(struct aui *x)
+{
+	assert(x);
+	aui_one(x);
+	aui_inc(x);
+	return;
+}
+
+void aui_and(struct aui *x, const struct aui *y)
+{
+	assert(x);
+	assert(y);
+	aui_and3(x, x, y);
+	return;
+}
+
+void aui_ior(struct aui *x, const struct aui *y)
+{
+	assert(x);
+	assert(y);
+	aui_ior3(x, x, y);
+	return;
+}
+
+void aui_xor(struct aui *x, const struct aui *y)
+{
+	assert(x);
+	assert(y);
+	aui_xor3(x, x, y);
+	return;
+}
+
+/*
+ * The three-operand functions set r = x op y, truncated to the length of
+ * r, with x and y zero-extended as needed; r may be identical to x or y
+ * (or both) but must not otherwise overlap them.
+ */
+void aui_and3(struct aui *r, const struct aui *x, const struct aui *y)
+{
+	size_t n;
+
+	assert(r);
+	assert(x);
+	assert(y);
+	n = (x->length < y->length) ? x->length : y->length;
+	n = (n < r->length) ? n : r->length;
+	bitwise(r->array, x->array, y->array, n, AND);
+	memset(r->array + n, 0, sizeof(*r->array) * (r->length - n));
+	return;
+}
+
+/* r = x op y for op IOR or XOR, which leave the longer operand's limbs as they are */
+static void bitwise3(struct aui *r, const struct aui *x, const struct aui *y, int op)
+{
+	const struct aui *z;
+	size_t n;
+	size_t m;
+
+	if (x->length < y->length) {
+		z = x;
+		x = y;
+		y = z;
+	}
+	n = (x->length < r->length) ? x->length : r->length;
+	m = (y->length < n) ? y->length : n;
+	bitwise(r->array, x->array, y->array, m, op);
+	if (r->array != x->array)
+		memcpy(r->array + m, x->array + m, sizeof(*r->array) * (n - m));
+	memset(r->array + n, 0, sizeof(*r->array) * (r->length - n));
+	return;
+}
+
+void aui_ior3(struct aui *r, const struct aui *x, const struct aui *y)
+{
+	assert(r);
+	assert(x);
+	assert(y);
+	bitwise3(r, x, y, IOR);
+	return;
+}
+
+void aui_xor3(struct aui *r, const struct aui *x, const struct aui *y)
+{
+	assert(r);
+	assert(x);
+	assert(y);
+	bitwise3(r, x, y, XOR);
+	return;
+}
+
+void aui_shl(struct aui *x, size_t shift)
+{
+	unsigned int bits;
+
+	assert(x);
+	if (!shift)
+		return;
+	bits = shift % AUI_TYPE_BIT;
+	shift /= AUI_TYPE_BIT;
+	if (shift >= x->length) {
+		memset(x->array, 0, sizeof(*x->array) * x->length);
+		return;
+	}
+	if (bits)
+		lshift(x->array + shift, x->array, x->length - shift, bits);
+	else
+		memmove(x->array + shift, x->array, sizeof(*x->array) * (x->length - shift));
+	memset(x->array, 0, sizeof(*x->array) * shift);
+	return;
+}
+
+void aui_shr(struct aui *x, size_t shift)
+{
+	unsigned int bits;
+
+	assert(x);
+	if (!shift)
+		return;
+	bits = shift % AUI_TYPE_BIT;
+	shift /= AUI_TYPE_BIT;
+	if (shift >= x->length) {
+		memset(x->array, 0, sizeof(*x->array) * x->length);
+		return;
+	}
+	if (bits)
+		rshift(x->array, x->array + shift, x->length - shift, bits);
+	else
+		memmove(x->array, x->array + shift, sizeof(*x->array) * (x->length - shift));
+	memset(x->array + x->length - shift, 0, sizeof(*x->array) * shift);
+	return;
+}
+
+void aui_inc(struct aui *x)
+{
+	size_t i;
+	AUI_TYPE index;
+
+	assert(x);
+	i = 0;
+	while ((i < x->length) && (x->array[i] == AUI_TYPE_MAX))
+		i++;
+	if (i < x->length) {
+		index = aui_lsbn(~x->array[i]);
+		x->array[i] = ((x->array[i] >> index) | 1) << index;
+	}
+	while (i--)
+		x->array[i] = 0;
+	return;
+}
+
+void aui_dec(struct aui *x)
+{
+	size_t i;
+	AUI_TYPE index;
+
+	assert(x);
+	i = 0;
+	while ((i < x->length) && (x->array[i] == 0))
+		i++;
+	if (i < x->length) {
+		index = aui_lsbn(x->array[i]);
+		x->array[i] ^= (AUI_TYPE_MAX >> (AUI_TYPE_BIT - 1 - index));
+	}
+	while (i--)
+		x->array[i] = AUI_TYPE_MAX;
 	return;
 }
 
-AUI_TYPE aui_msbn(AUI_TYPE native)
+int aui_add(struct aui *x, const struct aui *y)
 {
-	assert(native);
-	native |= native >> 1;
-#if (AUI_TYPE_BIT >= 4)
-	native |= native >> 2;
-#if (AUI_TYPE_BIT >= 8)
-	native |= native >> 4;
-#if (AUI_TYPE_BIT >= 16)
-	native |= native >> 8;
-#if (AUI_TYPE_BIT >= 32)
-	native |= native >> 16;
-#if (AUI_TYPE_BIT >= 64)
-	native |= native >> 32;
-#if (AUI_TYPE_BIT >= 128)
-	native |= native >> 64;
-#if (AUI_TYPE_BIT >= 256)
-	native |= native >> 128;
-#if (AUI_TYPE_BIT >= 512)
-	native |= native >> 256;
-	/* ... */
-#endif
-#endif
-#endif
-#endif
-#endif
-#endif
-#endif
-#endif
-	return most[(AUI_TYPE)(native * debruijn) >> shift];
+	size_t length;
+	AUI_TYPE carry;
+
+	assert(x);
+	assert(y);
+	length = (x->length < y->length) ? x->length : y->length;
+	carry = add_n(x->array, x->array, y->array, length, 0);
+	add_1(x->array + length, x->array + length, x->length - length, carry);
+	return 1;
 }
 
-AUI_TYPE aui_lsbn(AUI_TYPE native)
+int aui_sub(struct aui *x, const struct aui *y)
 {
-	assert(native);
-	return least[(AUI_TYPE)((native & (-native)) * debruijn) >> shift];
+	size_t length;
+	AUI_TYPE borrow;
+
+	assert(x);
+	assert(y);
+	length = (x->length < y->length) ? x->length : y->length;
+	borrow = sub_n(x->array, x->array, y->array, length, 0);
+	sub_1(x->array + length, x->array + length, x->length - length, borrow);
+	return 1;
 }
 
-unsigned long aui_msba(const struct aui *x)
+int aui_add3(struct aui *r, const struct aui *x, const struct aui *y)
 {
-	unsigned int i;
+	const struct aui *z;
+	size_t n;
+	size_t m;
+	AUI_TYPE carry;
 
+	assert(r);
 	assert(x);
-	i = x->length;
-	while (i && !x->array[--i]);
-	if (x->array[i])
-		return (AUI_TYPE_BIT * i + aui_msbn(x->array[i]));
-	return ULONG_MAX;
+	assert(y);
+	if (x->length < y->length) {
+		z = x;
+		x = y;
+		y = z;
+	}
+	n = (x->length < r->length) ? x->length : r->length;
+	m = (y->length < n) ? y->length : n;
+	carry = add_n(r->array, x->array, y->array, m, 0);
+	carry = add_1(r->array + m, x->array + m, n - m, carry);
+	if (n < r->length) {
+		r->array[n] = carry;
+		memset(r->array + n + 1, 0, sizeof(*r->array) * (r->length - n - 1));
+	}
+	return 1;
 }
 
-unsigned long aui_lsba(const struct aui *x)
+int aui_sub3(struct aui *r, const struct aui *x, const struct aui *y)
 {
-	unsigned int i;
+	size_t n;
+	size_t m;
+	size_t i;
+	AUI_TYPE borrow;
+	AUI_TYPE binary;
 
+	assert(r);
 	assert(x);
-	i = 0;
-	while ((i < x->length) && !x->array[i])
+	assert(y);
+	n = (x->length < r->length) ? x->length : r->length;
+	m = (y->length < r->length) ? y->length : r->length;
+	i = (n < m) ? n : m;
+	borrow = sub_n(r->array, x->array, y->array, i, 0);
+	borrow = sub_1(r->array + i, x->array + i, n - i, borrow);
+	/* past the end of x, r = 0 - y - borrow */
+	i = n;
+	while (i < m) {
+		binary = y->array[i];
+		r->array[i] = 0 - binary - borrow;
+		borrow |= !!binary;
 		i++;
-	if ((i < x->length) && x->array[i])
-		return (AUI_TYPE_BIT * i + aui_lsbn(x->array[i]));
-	return ULONG_MAX;
+	}
+	memset(r->array + i, borrow ? -1 : 0, sizeof(*r->array) * (r->length - i));
+	return 1;
 }
 
-struct aui *aui_alloc(unsigned int length)
+AUI_TYPE aui_addc(struct aui *x, const struct aui *y, AUI_TYPE carry)
 {
-	struct aui *x;
+	size_t length;
 
-	assert(length);
-	if (!(x = malloc(sizeof(*x))))
-		return NULL;
-	if (!(x->array = malloc(sizeof(*x->array) * length))) {
-		free(x);
-		return NULL;
-	}
-	x->length = length;
-	return x;
+	assert(x);
+	assert(y);
+	assert(carry <= 1);
+	/* the carry out would miss the limbs of y past the length of x */
+	assert(highest(y->array, y->length) <= x->length);
+	length = (x->length < y->length) ? x->length : y->length;
+	carry = add_n(x->array, x->array, y->array, length, carry);
+	return add_1(x->array + length, x->array + length, x->length - length, carry);
 }
 
-void aui_free(struct aui *x)
+AUI_TYPE aui_subc(struct aui *x, const struct aui *y, AUI_TYPE borrow)
 {
+	size_t length;
+
 	assert(x);
-	free(x->array);
-	free(x);
-	return;
+	assert(y);
+	assert(borrow <= 1);
+	/* the carry out would miss the limbs of y past the length of x */
+	assert(highest(y->array, y->length) <= x->length);
+	length = (x->length < y->length) ? x->length : y->length;
+	borrow = sub_n(x->array, x->array, y->array, length, borrow);
+	return sub_1(x->array + length, x->array + length, x->length - length, borrow);
 }
 
-struct aui *aui_pull(unsigned int length)
+AUI_TYPE aui_shlc(struct aui *x, size_t shift, AUI_TYPE carry)
 {
-	struct aui *x;
-	struct aui *y;
+	AUI_TYPE out;
 
-	assert(length);
-	x = list;
-	while (x && (x->length > length)) {
-		y = x;
-		x = x->next;
-	}
-	if (x && (x->length == length)) {
-		if (x == list)
-			list = list->next;
-		else
-			y->next = x->next;
-		return x;
-	}
-	return aui_alloc(length);
+	assert(x);
+	assert(shift < AUI_TYPE_BIT);
+	/* the bits of x << shift past the length of x */
+	out = 0;
+	if (shift && x->length)
+		out = x->array[x->length - 1] >> (AUI_TYPE_BIT - shift);
+	aui_shl(x, shift);
+	if (x->length)
+		x->array[0] |= carry;
+	return out;
 }
 
-void aui_push(struct aui *x)
+unsigned int aui_threads(unsigned int count)
 {
-	struct aui *y;
+	assert(count);
+#ifdef AUI_THREADS
+	threads = (count < 64) ? count : 64;
+	return threads;
+#else
+	return !!count;
+#endif
+}
 
+int aui_mul(struct aui *x, const struct aui *y)
+{
 	assert(x);
-	x->next = list;
-	while (x->next && (x->next->length > x->length)) {
-		y = x->next;
-		x->next = x->next->next;
-	}
-	if (x->next == list)
-		list = x;
-	else
-		y->next = x;
-	return;
+	assert(y);
+	return aui_mul3(x, x, y);
 }
 
-void aui_wipe(void)
+int aui_mul3(struct aui *r, const struct aui *x, const struct aui *y)
 {
-	struct aui *x;
+	const struct aui *z;
+	struct aui *a;
+	size_t n;
+	size_t m;
+	size_t i;
+	size_t j;
+	AUI_TYPE carry;
+	unsigned int count;
 
-	while ((x = list)) {
-		list = list->next;
-		aui_free(x);
+	assert(r);
+	assert(x);
+	assert(y);
+	/* the product can't be formed in place */
+	if ((r->array == x->array) || (r->array == y->array)) {
+		if (!(a = aui_pull(r->length)))
+			return 0;
+		aui_mul3(a, x, y);
+		aui_swap(r, a);
+		aui_push(a);
+		return 1;
 	}
-	return;
+	if (x->length < y->length) {
+		z = x;
+		x = y;
+		y = z;
+	}
+	n = (x->length < r->length) ? x->length : r->length;
+	m = (y->length < n) ? y->length : n;
+	if (n == r->length) {
+		count = 1;
+#ifdef AUI_THREADS
+		count = threads;
+#endif
+		product(r->array, x->array, n, y->array, m, count);
+		return 1;
+	}
+	/* both operands are shorter than r, which gets the whole product */
+	memset(r->array, 0, sizeof(*r->array) * r->length);
+	n = highest(x->array, n);
+	m = highest(y->array, m);
+	i = 0;
+	while (i < m) {
+		if (y->array[i]) {
+			j = ((r->length - i) < n) ? (r->length - i) : n;
+			carry = addmul_1(r->array + i, x->array, j, y->array[i]);
+			if ((i + j) < r->length)
+				r->array[i + j] = carry;
+		}
+		i++;
+	}
+	return 1;
 }
 
-void aui_seti(struct aui *x, unsigned long value)
+int aui_div(struct aui *x, const struct aui *y)
 {
-	unsigned int i;
+	assert(x);
+	assert(y);
+	return aui_div3(x, x, y);
+}
 
+int aui_mod(struct aui *x, const struct aui *y)
+{
 	assert(x);
-	i = x->length;
-	while (i > (sizeof(value) / sizeof(*x->array)))
-		x->array[--i] = 0;
-	while (i--)
-		x->array[i] = value >> (AUI_TYPE_BIT * i);
-	return;
+	assert(y);
+	return aui_mod3(x, x, y);
 }
 
-int aui_sets(struct aui *x, const char *string, const char *set, int base)
+/* the quotient goes straight into r when it fits, the dividend is never copied */
+int aui_div3(struct aui *r, const struct aui *x, const struct aui *y)
 {
-	struct aui *a;
-	struct aui *b;
+	AUI_TYPE *q;
+	size_t n;
+	size_t m;
+	size_t length;
 	int result;
-	int value;
-	size_t i;
 
+	assert(r);
 	assert(x);
-	assert(string);
-	assert(set);
-	assert(base >= 2);
-	assert(base <= CHAR_MAX);
-	if (!(a = aui_pull(AUI_SIZTOLEN(sizeof(*set)))))
+	assert(y);
+	if (!(m = highest(y->array, y->length))) {
+		raise(SIGFPE);
 		return 0;
-	result = 0;
-	if (!(b = aui_pull(x->length)))
-		goto push_a;
-	aui_seti(x, 0);
-	aui_seti(a, base);
-	i = 0;
-	while ((value = chartoint(string[i], set, base)) >= 0) {
-		aui_seti(b, value);
-		if (!aui_mul(x, a))
-			goto push_b;
-		if (!aui_add(x, b))
-			goto push_b;
-		i++;
 	}
+	n = highest(x->array, x->length);
+	if (n < m) {
+		memset(r->array, 0, sizeof(*r->array) * r->length);
+		return 1;
+	}
+	length = n - m + 1;
+	q = r->array;
+	if ((length > r->length) && !(q = malloc(sizeof(*q) * length)))
+		return 0;
 	result = 1;
-push_b:
-	aui_push(b);
-push_a:
-	aui_push(a);
+	if (m == 1)
+		divmod_1(q, x->array, n, y->array[0]);
+	else
+		result = divmod_n(q, NULL, x->array, n, y->array, m);
+	if (q == r->array) {
+		if (result)
+			memset(r->array + length, 0, sizeof(*r->array) * (r->length - length));
+		return result;
+	}
+	if (result)
+		memcpy(r->array, q, sizeof(*r->array) * r->length);
+	free(q);
 	return result;
 }
 
-unsigned long aui_geti(const struct aui *x)
+int aui_mod3(struct aui *r, const struct aui *x, const struct aui *y)
 {
-	unsigned long value;
-	unsigned int i;
+	AUI_TYPE *remainder;
+	size_t n;
+	size_t m;
+	int result;
 
+	assert(r);
 	assert(x);
-	value = 0;
-	i = sizeof(value) / sizeof(*x->array);
-	i = (x->length < i) ? x->length : i;
-	while (i--)
-		value |= (unsigned long)x->array[i] << (AUI_TYPE_BIT * i);
-	return value;
+	assert(y);
+	if (!(m = highest(y->array, y->length))) {
+		raise(SIGFPE);
+		return 0;
+	}
+	n = highest(x->array, x->length);
+	if (n < m) {
+		aui_asgn(r, x);
+		return 1;
+	}
+	if (m == 1) {
+		remainder = r->array;
+		remainder[0] = divmod_1(NULL, x->array, n, y->array[0]);
+		memset(r->array + 1, 0, sizeof(*r->array) * (r->length - 1));
+		return 1;
+	}
+	remainder = r->array;
+	if ((m > r->length) && !(remainder = malloc(sizeof(*remainder) * m)))
+		return 0;
+	result = divmod_n(NULL, remainder, x->array, n, y->array, m);
+	if (remainder == r->array) {
+		if (result)
+			memset(r->array + m, 0, sizeof(*r->array) * (r->length - m));
+		return result;
+	}
+	if (result)
+		memcpy(r->array, remainder, sizeof(*r->array) * r->length);
+	free(remainder);
+	return result;
 }
 
-int aui_gets(char *string, size_t size, const char *set, int base, const struct aui *x)
+/*
+ * The fused functions set x += y * z, x -= y * z, x += y << shift and
+ * x -= y << shift, truncated to the length of x, without forming the
+ * product or the shifted copy. x may be identical to y or z, at the cost
+ * of a temporary, but must not otherwise overlap them.
+ */
+static int mul_acc(struct aui *x, const struct aui *y, const struct aui *z, int subtract)
 {
+	const struct aui *w;
 	struct aui *a;
-	struct aui *b;
-	struct aui *c;
-	int result;
+	size_t n;
+	size_t m;
 	size_t i;
 	size_t j;
-	char character;
+	AUI_TYPE carry;
 
-	assert(string);
-	assert(size);
-	assert(set);
-	assert(base >= 2);
-	assert(base <= CHAR_MAX);
-	assert(x);
-	if (!(a = aui_pull(AUI_SIZTOLEN(sizeof(*set)))))
-		return 0;
-	result = 0;
-	if (!(b = aui_pull(x->length)))
-		goto push_a;
-	if (!(c = aui_pull(x->length)))
-		goto push_b;
-	aui_seti(a, base);
-	aui_asgn(b, x);
-	i = 0;
-	while (aui_eval(b) && (i < size)) {
-		aui_asgn(c, b);
-		if (!aui_mod(c, a))
-			goto push_c;
-		if (!aui_div(b, a))
-			goto push_c;
-		string[i++] = set[aui_geti(c)];
-	}
-	string[i] = '\0';
-	if (i--) {
-		j = 0;
-		while (j < i) {
-			character = string[i];
-			string[i--] = string[j];
-			string[j++] = character;
+	if ((x->array == y->array) || (x->array == z->array)) {
+		if (!(a = aui_pull(x->length)))
+			return 0;
+		aui_mul3(a, y, z);
+		if (subtract)
+			aui_sub(x, a);
+		else
+			aui_add(x, a);
+		aui_push(a);
+		return 1;
+	}
+	n = highest(y->array, (y->length < x->length) ? y->length : x->length);
+	m = highest(z->array, (z->length < x->length) ? z->length : x->length);
+	/* the longer operand makes the rows */
+	if (n < m) {
+		w = y;
+		y = z;
+		z = w;
+		i = n;
+		n = m;
+		m = i;
+	}
+	i = 0;
+	while (i < m) {
+		if (z->array[i]) {
+			j = ((x->length - i) < n) ? (x->length - i) : n;
+			if (subtract) {
+				carry = submul_1(x->array + i, y->array, j, z->array[i]);
+				sub_1(x->array + i + j, x->array + i + j, x->length - i - j, carry);
+			} else {
+				carry = addmul_1(x->array + i, y->array, j, z->array[i]);
+				add_1(x->array + i + j, x->array + i + j, x->length - i - j, carry);
+			}
 		}
+		i++;
 	}
-	result = 1;
-push_c:
-	aui_push(c);
-push_b:
-	aui_push(b);
-push_a:
-	aui_push(a);
-	return result;
+	return 1;
 }
 
-void aui_asgn(struct aui *x, const struct aui *y)
+static int shl_acc(struct aui *x, const struct aui *y, size_t shift, int subtract)
 {
-	unsigned int i;
+	struct aui *a;
+	size_t limbs;
+	size_t n;
+	unsigned int bits;
+	AUI_TYPE carry;
+	int result;
+
+	limbs = shift / AUI_TYPE_BIT;
+	bits = shift % AUI_TYPE_BIT;
+	if (limbs >= x->length)
+		return 1;
+	if (x->array == y->array) {
+		if (!(a = aui_pull(x->length)))
+			return 0;
+		aui_asgn(a, y);
+		result = shl_acc(x, a, shift, subtract);
+		aui_push(a);
+		return result;
+	}
+	n = x->length - limbs;
+	n = (y->length < n) ? y->length : n;
+	if (!bits)
+		carry = subtract ? sub_n(x->array + limbs, x->array + limbs, y->array, n, 0)
+			: add_n(x->array + limbs, x->array + limbs, y->array, n, 0);
+	else if (subtract)
+		carry = subshl_n(x->array + limbs, y->array, n, bits);
+	else
+		carry = addshl_n(x->array + limbs, y->array, n, bits);
+	/* the bits shifted out of y, unless they are past the end of x */
+	if (bits && (n == y->length))
+		carry += y->array[n - 1] >> (AUI_TYPE_BIT - bits);
+	limbs += n;
+	if (subtract)
+		sub_1(x->array + limbs, x->array + limbs, x->length - limbs, carry);
+	else
+		add_1(x->array + limbs, x->array + limbs, x->length - limbs, carry);
+	return 1;
+}
 
+int aui_addmul(struct aui *x, const struct aui *y, const struct aui *z)
+{
 	assert(x);
 	assert(y);
-	i = x->length;
-	while (i > y->length)
-		x->array[--i] = 0;
-	while (i--)
-		x->array[i] = y->array[i];
-	return;
+	assert(z);
+	return mul_acc(x, y, z, 0);
 }
 
-void aui_swap(struct aui *x, struct aui *y)
+int aui_submul(struct aui *x, const struct aui *y, const struct aui *z)
 {
-	unsigned int i;
-	AUI_TYPE *array;
-	AUI_TYPE binary;
+	assert(x);
+	assert(y);
+	assert(z);
+	return mul_acc(x, y, z, 1);
+}
 
+int aui_addshl(struct aui *x, const struct aui *y, size_t shift)
+{
 	assert(x);
 	assert(y);
-	if (x->length == y->length) {
-		array = x->array;
-		x->array = y->array;
-		y->array = array;
-		return;
+	return shl_acc(x, y, shift, 0);
+}
+
+int aui_subshl(struct aui *x, const struct aui *y, size_t shift)
+{
+	assert(x);
+	assert(y);
+	return shl_acc(x, y, shift, 1);
+}
+
+int aui_add_batch(struct aui *x, const struct aui *y, size_t count)
+{
+	size_t length;
+	size_t i;
+	AUI_TYPE carry;
+
+	assert(x || !count);
+	assert(y || !count);
+	i = 0;
+	while (i < count) {
+		if ((i + 1) < count) {
+			PREFETCH(x[i + 1].array, 1);
+			PREFETCH(y[i + 1].array, 0);
+		}
+		length = (x[i].length < y[i].length) ? x[i].length : y[i].length;
+		carry = add_n(x[i].array, x[i].array, y[i].array, length, 0);
+		add_1(x[i].array + length, x[i].array + length, x[i].length - length, carry);
+		i++;
 	}
-	i = (x->length > y->length) ? x->length : y->length;
-	while (i > y->length)
-		x->array[--i] = 0;
-	while (i > x->length)
-		y->array[--i] = 0;
-	while (i--) {
-		binary = x->array[i];
-		x->array[i] = y->array[i];
-		y->array[i] = binary;
+	return 1;
+}
+
+int aui_sub_batch(struct aui *x, const struct aui *y, size_t count)
+{
+	size_t length;
+	size_t i;
+	AUI_TYPE borrow;
+
+	assert(x || !count);
+	assert(y || !count);
+	i = 0;
+	while (i < count) {
+		if ((i + 1) < count) {
+			PREFETCH(x[i + 1].array, 1);
+			PREFETCH(y[i + 1].array, 0);
+		}
+		length = (x[i].length < y[i].length) ? x[i].length : y[i].length;
+		borrow = sub_n(x[i].array, x[i].array, y[i].array, length, 0);
+		sub_1(x[i].array + length, x[i].array + length, x[i].length - length, borrow);
+		i++;
 	}
-	return;
+	return 1;
 }
 
-int aui_eq(const struct aui *x, const struct aui *y)
+int aui_mul_batch(struct aui *x, const struct aui *y, size_t count)
 {
-	unsigned int i;
+	size_t i;
+	struct aui *a;
 
-	assert(x);
-	assert(y);
-	i = (x->length > y->length) ? x->length : y->length;
-	while (i > y->length)
-		if (x->array[--i])
-			return 0;
-	while (i > x->length)
-		if (y->array[--i])
-			return 0;
-	while (i--)
-		if (x->array[i] != y->array[i])
-			return 0;
+	assert(x || !count);
+	assert(y || !count);
+	a = NULL;
+	i = 0;
+	while (i < count) {
+		if ((i + 1) < count) {
+			PREFETCH(x[i + 1].array, 1);
+			PREFETCH(y[i + 1].array, 0);
+		}
+		if (!a || (a->length != x[i].length)) {
+			if (a)
+				aui_push(a);
+			if (!(a = aui_pull(x[i].length)))
+				return 0;
+		}
+		mul(a->array, x[i].array, x[i].length, y[i].array, y[i].length);
+		memcpy(x[i].array, a->array, sizeof(*x[i].array) * x[i].length);
+		i++;
+	}
+	if (a)
+		aui_push(a);
 	return 1;
 }
 
-int aui_neq(const struct aui *x, const struct aui *y)
+struct aui_vector *aui_vector_alloc(size_t length, size_t count)
 {
-	assert(x);
-	assert(y);
-	return !aui_eq(x, y);
+	struct aui_vector *x;
+
+	assert(length);
+	assert(count);
+	if (count > ((size_t)-1 / sizeof(*x->array) / length))
+		return NULL;
+	if (!(x = malloc(sizeof(*x))))
+		return NULL;
+	if (!(x->array = malloc(sizeof(*x->array) * length * count))) {
+		free(x);
+		return NULL;
+	}
+	x->length = length;
+	x->count = count;
+	return x;
 }
 
-int aui_lt(const struct aui *x, const struct aui *y)
+void aui_vector_free(struct aui_vector *x)
 {
-	unsigned int i;
-
 	assert(x);
-	assert(y);
-	i = (x->length > y->length) ? x->length : y->length;
-	while (i > y->length)
-		if (x->array[--i])
-			return 0;
-	while (i > x->length)
-		if (y->array[--i])
-			return 1;
-	while (i--)
-		if (x->array[i] != y->array[i])
-			return (x->array[i] < y->array[i]);
-	return 0;
+	free(x->array);
+	free(x);
+	return;
 }
 
-int aui_lte(const struct aui *x, const struct aui *y)
+void aui_vector_get(struct aui *x, const struct aui_vector *y, size_t index)
 {
+	size_t i;
+
 	assert(x);
 	assert(y);
-	return !aui_gt(x, y);
+	assert(index < y->count);
+	i = x->length;
+	while (i > y->length)
+		x->array[--i] = 0;
+	while (i--)
+		x->array[i] = y->array[i * y->count + index];
+	return;
 }
 
-int aui_gt(const struct aui *x, const struct aui *y)
+void aui_vector_set(struct aui_vector *x, size_t index, const struct aui *y)
 {
-	unsigned int i;
+	size_t i;
 
 	assert(x);
 	assert(y);
-	i = (x->length > y->length) ? x->length : y->length;
+	assert(index < x->count);
+	i = x->length;
 	while (i > y->length)
-		if (x->array[--i])
-			return 1;
-	while (i > x->length)
-		if (y->array[--i])
-			return 0;
+		x->array[--i * x->count + index] = 0;
 	while (i--)
-		if (x->array[i] != y->array[i])
-			return (x->array[i] > y->array[i]);
-	return 0;
+		x->array[i * x->count + index] = y->array[i];
+	return;
 }
 
-int aui_gte(const struct aui *x, const struct aui *y)
+void aui_vector_add(struct aui_vector *x, const struct aui_vector *y)
 {
 	assert(x);
 	assert(y);
-	return !aui_lt(x, y);
+	assert(x->length == y->length);
+	assert(x->count == y->count);
+	lanes_add(x->array, y->array, x->length, x->count, x->count);
+	return;
 }
 
-int aui_eval(const struct aui *x)
+void aui_vector_sub(struct aui_vector *x, const struct aui_vector *y)
 {
-	unsigned int i;
-
 	assert(x);
-	i = 0;
-	while (i < x->length)
-		if (x->array[i++])
-			return 1;
-	return 0;
+	assert(y);
+	assert(x->length == y->length);
+	assert(x->count == y->count);
+	lanes_sub(x->array, x->array, y->array, x->length, x->count, x->count, NULL);
+	return;
 }
 
-void aui_one(struct aui *x)
+void aui_vector_and(struct aui_vector *x, const struct aui_vector *y)
 {
-	unsigned int i;
-
 	assert(x);
-	i = x->length;
-	while (i--)
-		x->array[i] = ~x->array[i];
+	assert(y);
+	assert(x->length == y->length);
+	assert(x->count == y->count);
+	bitwise(x->array, x->array, y->array, x->length * x->count, AND);
 	return;
 }
 
-void aui_two(struct aui *x)
+void aui_vector_ior(struct aui_vector *x, const struct aui_vector *y)
 {
 	assert(x);
-	aui_one(x);
-	aui_inc(x);
+	assert(y);
+	assert(x->length == y->length);
+	assert(x->count == y->count);
+	bitwise(x->array, x->array, y->array, x->length * x->count, IOR);
 	return;
 }
 
-void aui_and(struct aui *x, const struct aui *y)
+void aui_vector_xor(struct aui_vector *x, const struct aui_vector *y)
 {
-	unsigned int i;
-
 	assert(x);
 	assert(y);
-	i = x->length;
-	while (i > y->length)
-		x->array[--i] = 0;
-	while (i--)
-		x->array[i] &= y->array[i];
+	assert(x->length == y->length);
+	assert(x->count == y->count);
+	bitwise(x->array, x->array, y->array, x->length * x->count, XOR);
 	return;
 }
 
-void aui_ior(struct aui *x, const struct aui *y)
+void aui_vector_eq(unsigned char *result, const struct aui_vector *x, const struct aui_vector *y)
 {
-	unsigned int i;
+	size_t i;
+	size_t j;
 
+	assert(result);
 	assert(x);
 	assert(y);
-	i = (x->length < y->length) ? x->length : y->length;
-	while (i--)
-		x->array[i] |= y->array[i];
+	assert(x->length == y->length);
+	assert(x->count == y->count);
+	memset(result, 1, x->count);
+	i = 0;
+	while (i < x->length) {
+		j = 0;
+		while (j < x->count) {
+			result[j] &= (x->array[i * x->count + j] == y->array[i * x->count + j]);
+			j++;
+		}
+		i++;
+	}
 	return;
 }
 
-void aui_xor(struct aui *x, const struct aui *y)
+void aui_vector_lt(unsigned char *result, const struct aui_vector *x, const struct aui_vector *y)
 {
-	unsigned int i;
+	AUI_TYPE borrow[256];
+	size_t i;
+	size_t j;
+	size_t n;
 
+	assert(result);
 	assert(x);
 	assert(y);
-	i = (x->length < y->length) ? x->length : y->length;
-	while (i--)
-		x->array[i] ^= y->array[i];
+	assert(x->length == y->length);
+	assert(x->count == y->count);
+	j = 0;
+	while (j < x->count) {
+		n = ((x->count - j) < 256) ? (x->count - j) : 256;
+		lanes_sub(NULL, x->array + j, y->array + j, x->length, x->count, n, borrow);
+		i = 0;
+		while (i < n) {
+			result[j + i] = borrow[i];
+			i++;
+		}
+		j += n;
+	}
 	return;
 }
 
-void aui_shl(struct aui *x, unsigned long shift)
+/*
+ * Fixed-width kernels over n words, forced inline into the functions
+ * AUI_FIXED() declares: n is a constant there, so the compiler unrolls the
+ * loops (up to 16 words, 1024 bits on x86-64). On x86-64, the limbs of a
+ * fixed-width integer form little-endian 64-bit words whatever AUI_TYPE
+ * is, and the kernels work on those.
+ */
+#ifdef __GNUC__
+#define FIXED_INLINE __inline__ __attribute__((always_inline))
+#else
+#define FIXED_INLINE
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+__extension__ typedef unsigned long long word;
+__extension__ typedef unsigned __int128 dword;
+#define WORD_BIT 64
+#else
+typedef AUI_TYPE word;
+#define WORD_BIT AUI_TYPE_BIT
+#endif
+
+/* x * y as a double word; returns the low word and stores the high word in *hi */
+static FIXED_INLINE word fixed_mul_ll(word *hi, word x, word y)
 {
-	AUI_TYPE bits;
-	AUI_TYPE delta;
-	unsigned int i;
-	unsigned int j;
+#if defined(__GNUC__) && defined(__x86_64__)
+	dword product;
 
-	assert(x);
-	if (!shift)
-		return;
-	bits = shift % AUI_TYPE_BIT;
-	shift /= AUI_TYPE_BIT;
-	i = x->length;
-	if (shift >= x->length)
-		goto while_fill;
-	delta = AUI_TYPE_BIT - bits;
-	j = i - shift - 1;
-	if (delta != AUI_TYPE_BIT) {
-		goto while_shift;
-		while (j) {
-			x->array[i] |= x->array[--j] >> delta;
-while_shift:
-			x->array[--i] = x->array[j] << bits;
-		}
-	} else {
-		goto while_zero;
-		while (j) {
-			x->array[i] = 0, j--;
-while_zero:
-			x->array[--i] = x->array[j] << bits;
-		}
-	}
-while_fill:
-	while (i--)
-		x->array[i] = 0;
-	return;
+	product = (dword)x * y;
+	*hi = product >> WORD_BIT;
+	return product;
+#else
+	return mul_ll(hi, x, y);
+#endif
 }
 
-void aui_shr(struct aui *x, unsigned long shift)
+/* word i of the limbs of x; memcpy() compiles to a single move */
+static FIXED_INLINE word fixed_load(const AUI_TYPE *x, size_t i)
 {
-	AUI_TYPE bits;
-	AUI_TYPE delta;
-	unsigned int i;
-	unsigned int j;
+	word value;
 
-	assert(x);
-	if (!shift)
-		return;
-	bits = shift % AUI_TYPE_BIT;
-	shift /= AUI_TYPE_BIT;
-	i = 0;
-	if (shift >= x->length)
-		goto while_fill;
-	delta = AUI_TYPE_BIT - bits;
-	j = shift;
-	if (delta != AUI_TYPE_BIT) {
-		goto while_shift;
-		while (j < x->length) {
-			x->array[i++] |= x->array[j] << delta;
-while_shift:
-			x->array[i] = x->array[j++] >> bits;
-		}
-	} else {
-		goto while_zero;
-		while (j < x->length) {
-			x->array[i++] = 0;
-while_zero:
-			x->array[i] = x->array[j++] >> bits;
-		}
-	}
-	i++;
-while_fill:
-	while (i < x->length)
-		x->array[i++] = 0;
+	memcpy(&value, (const unsigned char *)x + sizeof(value) * i, sizeof(value));
+	return value;
+}
+
+static FIXED_INLINE void fixed_store(AUI_TYPE *x, size_t i, word value)
+{
+	memcpy((unsigned char *)x + sizeof(value) * i, &value, sizeof(value));
 	return;
 }
 
-void aui_inc(struct aui *x)
+static FIXED_INLINE int fixed_eq(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
 {
-	unsigned int i;
-	AUI_TYPE index;
+	word difference;
+	size_t i;
 
-	assert(x);
+	difference = 0;
 	i = 0;
-	while ((i < x->length) && (x->array[i] == AUI_TYPE_MAX))
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i < n) {
+		difference |= fixed_load(x, i) ^ fixed_load(y, i);
 		i++;
-	if (i < x->length) {
-		index = aui_lsbn(~x->array[i]);
-		x->array[i] = ((x->array[i] >> index) | 1) << index;
 	}
-	while (i--)
-		x->array[i] = 0;
-	return;
+	return !difference;
 }
 
-void aui_dec(struct aui *x)
+/* x < y if x - y borrows */
+static FIXED_INLINE int fixed_lt(const AUI_TYPE *x, const AUI_TYPE *y, size_t n)
 {
-	unsigned int i;
-	AUI_TYPE index;
+	word a;
+	word b;
+	int borrow;
+	size_t i;
 
-	assert(x);
+	borrow = 0;
 	i = 0;
-	while ((i < x->length) && (x->array[i] == 0))
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i < n) {
+		a = fixed_load(x, i);
+		b = fixed_load(y, i);
+		borrow = (a < b) | ((a == b) & borrow);
 		i++;
-	if (i < x->length) {
-		index = aui_lsbn(x->array[i]);
-		x->array[i] ^= (AUI_TYPE_MAX >> (AUI_TYPE_BIT - 1 - index));
 	}
-	while (i--)
-		x->array[i] = AUI_TYPE_MAX;
-	return;
+	return borrow;
 }
 
-int aui_add(struct aui *x, const struct aui *y)
+static FIXED_INLINE void fixed_shl(AUI_TYPE *x, size_t n, size_t shift)
 {
-	unsigned int length;
-	struct aui *a;
-	struct aui *b;
-	int result;
+	word value;
+	size_t words;
+	unsigned int bits;
+	size_t i;
 
-	assert(x);
-	assert(y);
-	length = (x->length > y->length) ? x->length : y->length;
-	if (!(a = aui_pull(length)))
-		return 0;
-	result = 0;
-	if (!(b = aui_pull(length)))
-		goto push_a;
-	aui_asgn(a, y);
-	while (aui_eval(a)) {
-		aui_asgn(b, x);
-		aui_and(b, a);
-		aui_shl(b, 1);
-		aui_xor(x, a);
-		aui_asgn(a, b);
+	words = shift / WORD_BIT;
+	bits = shift % WORD_BIT;
+	i = n;
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i--) {
+		value = 0;
+		if (i >= words) {
+			value = fixed_load(x, i - words) << bits;
+			if (bits && (i > words))
+				value |= fixed_load(x, i - words - 1) >> (WORD_BIT - bits);
+		}
+		fixed_store(x, i, value);
 	}
-	result = 1;
-	aui_push(b);
-push_a:
-	aui_push(a);
-	return result;
+	return;
 }
 
-int aui_sub(struct aui *x, const struct aui *y)
+static FIXED_INLINE void fixed_shr(AUI_TYPE *x, size_t n, size_t shift)
 {
-	unsigned int length;
-	struct aui *a;
-	struct aui *b;
-	int result;
+	word value;
+	size_t words;
+	unsigned int bits;
+	size_t i;
 
-	assert(x);
-	assert(y);
-	length = (x->length > y->length) ? x->length : y->length;
-	if (!(a = aui_pull(length)))
-		return 0;
-	result = 0;
-	if (!(b = aui_pull(length)))
-		goto push_a;
-	aui_asgn(a, y);
-	aui_two(a);
-	while (aui_eval(a)) {
-		aui_asgn(b, x);
-		aui_and(b, a);
-		aui_shl(b, 1);
-		aui_xor(x, a);
-		aui_asgn(a, b);
+	words = shift / WORD_BIT;
+	bits = shift % WORD_BIT;
+	i = 0;
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i < n) {
+		value = 0;
+		if (words < (n - i)) {
+			value = fixed_load(x, i + words) >> bits;
+			if (bits && ((words + 1) < (n - i)))
+				value |= fixed_load(x, i + words + 1) << (WORD_BIT - bits);
+		}
+		fixed_store(x, i, value);
+		i++;
 	}
-	result = 1;
-	aui_push(b);
-push_a:
-	aui_push(a);
-	return result;
+	return;
 }
 
-int aui_mul(struct aui *x, const struct aui *y)
+static FIXED_INLINE void fixed_add(AUI_TYPE *x, const AUI_TYPE *y, size_t n)
 {
-	unsigned int length;
-	struct aui *a;
-	struct aui *b;
-	int result;
+	word carry;
+	word sum;
+	word b;
+	size_t i;
 
-	assert(x);
-	assert(y);
-	length = (x->length > y->length) ? x->length : y->length;
-	if (!(a = aui_pull(length)))
-		return 0;
-	result = 0;
-	if (!(b = aui_pull(length)))
-		goto push_a;
-	aui_asgn(a, y);
-	aui_seti(b, 0);
-	aui_swap(x, b);
-	while (aui_eval(a)) {
-		if ((a->array[0] & 1) && !aui_add(x, b))
-			goto push_b;
-		aui_shl(b, 1);
-		aui_shr(a, 1);
+	carry = 0;
+	i = 0;
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i < n) {
+		b = fixed_load(y, i);
+		sum = fixed_load(x, i) + carry;
+		carry = (sum < carry);
+		sum += b;
+		carry += (sum < b);
+		fixed_store(x, i, sum);
+		i++;
 	}
-	result = 1;
-push_b:
-	aui_push(b);
-push_a:
-	aui_push(a);
-	return result;
+	return;
 }
 
-int aui_div(struct aui *x, const struct aui *y)
+static FIXED_INLINE void fixed_sub(AUI_TYPE *x, const AUI_TYPE *y, size_t n)
 {
-	unsigned long msby;
-	unsigned long msbx;
-	unsigned int length;
-	struct aui *a;
-	struct aui *b;
-	int result;
+	word borrow;
+	word difference;
+	word a;
+	word b;
+	size_t i;
 
-	assert(x);
-	assert(y);
-	if ((msby = aui_msba(y)) == ULONG_MAX) {
-		raise(SIGFPE);
-		return 0;
-	}
-	if (((msbx = aui_msba(x)) == ULONG_MAX) || (msbx <= msby)) {
-		aui_seti(x, aui_gte(x, y));
-		return 1;
-	}
-	length = (x->length > y->length) ? x->length : y->length;
-	if (!(a = aui_pull(length)))
-		return 0;
-	result = 0;
-	if (!(b = aui_pull(length)))
-		goto push_a;
-	aui_asgn(a, x);
-	aui_seti(x, 0);
-	while (aui_gte(a, y)) {
-		msbx = aui_msba(a) - msby;
-		aui_asgn(b, y);
-		aui_shl(b, msbx);
-		if (aui_lt(a, b)) {
-			aui_shr(b, 1);
-			msbx--;
-		}
-		x->array[msbx / AUI_TYPE_BIT] |= 1 << (msbx % AUI_TYPE_BIT);
-		if (!aui_sub(a, b))
-			goto push_b;
+	borrow = 0;
+	i = 0;
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i < n) {
+		a = fixed_load(x, i);
+		b = fixed_load(y, i);
+		difference = a - borrow;
+		borrow = (difference > a);
+		borrow += (difference < b);
+		fixed_store(x, i, difference - b);
+		i++;
 	}
-	result = 1;
-push_b:
-	aui_push(b);
-push_a:
-	aui_push(a);
-	return result;
+	return;
 }
 
-int aui_mod(struct aui *x, const struct aui *y)
+/* x = x * y, truncated to n words, through the product r */
+static FIXED_INLINE void fixed_mul(word *r, AUI_TYPE *x, const AUI_TYPE *y, size_t n)
 {
-	unsigned long msby;
-	unsigned long msbx;
-	unsigned int length;
-	struct aui *a;
-	int result;
+	word carry;
+	word hi;
+	word lo;
+	word b;
+	size_t i;
+	size_t j;
 
-	assert(x);
-	assert(y);
-	if ((msby = aui_msba(y)) == ULONG_MAX) {
-		raise(SIGFPE);
-		return 0;
+	i = 0;
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i < n) {
+		r[i] = 0;
+		i++;
 	}
-	if (((msbx = aui_msba(x)) == ULONG_MAX) || (msbx < msby))
-		return 1;
-	length = (x->length > y->length) ? x->length : y->length;
-	if (!(a = aui_pull(length)))
-		return 0;
-	result = 0;
-	while (aui_gte(x, y)) {
-		aui_asgn(a, y);
-		aui_shl(a, aui_msba(x) - msby);
-		if (aui_lt(x, a))
-			aui_shr(a, 1);
-		if (!aui_sub(x, a))
-			goto push_a;
+	i = 0;
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i < n) {
+		b = fixed_load(y, i);
+		carry = 0;
+		j = 0;
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+		while (j < (n - i)) {
+			lo = fixed_mul_ll(&hi, fixed_load(x, j), b);
+			lo += carry;
+			hi += (lo < carry);
+			r[i + j] += lo;
+			carry = hi + (r[i + j] < lo);
+			j++;
+		}
+		i++;
 	}
-	result = 1;
-push_a:
-	aui_push(a);
-	return result;
+	i = 0;
+#ifdef __GNUC__
+#pragma GCC unroll 16
+#endif
+	while (i < n) {
+		fixed_store(x, i, r[i]);
+		i++;
+	}
+	return;
+}
+
+#define FIXED(bits) \
+void aui##bits##_seti(struct aui##bits *x, unsigned long value) \
+{ \
+	size_t i; \
+\
+	assert(x); \
+	i = sizeof(x->array) / sizeof(*x->array); \
+	while (i > (sizeof(value) / sizeof(*x->array))) \
+		x->array[--i] = 0; \
+	while (i--) \
+		x->array[i] = value >> (AUI_TYPE_BIT * i); \
+	return; \
+} \
+\
+unsigned long aui##bits##_geti(const struct aui##bits *x) \
+{ \
+	struct aui a; \
+\
+	assert(x); \
+	a.array = (AUI_TYPE *)x->array; \
+	a.length = sizeof(x->array) / sizeof(*x->array); \
+	a.next = NULL; \
+	a.view = 0; \
+	return aui_geti(&a); \
+} \
+\
+void aui##bits##_get(struct aui *x, const struct aui##bits *y) \
+{ \
+	struct aui a; \
+\
+	assert(x); \
+	assert(y); \
+	a.array = (AUI_TYPE *)y->array; \
+	a.length = sizeof(y->array) / sizeof(*y->array); \
+	a.next = NULL; \
+	a.view = 0; \
+	aui_asgn(x, &a); \
+	return; \
+} \
+\
+void aui##bits##_set(struct aui##bits *x, const struct aui *y) \
+{ \
+	struct aui a; \
+\
+	assert(x); \
+	assert(y); \
+	a.array = x->array; \
+	a.length = sizeof(x->array) / sizeof(*x->array); \
+	a.next = NULL; \
+	a.view = 0; \
+	aui_asgn(&a, y); \
+	return; \
+} \
+\
+int aui##bits##_eq(const struct aui##bits *x, const struct aui##bits *y) \
+{ \
+	assert(x); \
+	assert(y); \
+	return fixed_eq(x->array, y->array, (bits) / WORD_BIT); \
+} \
+\
+int aui##bits##_lt(const struct aui##bits *x, const struct aui##bits *y) \
+{ \
+	assert(x); \
+	assert(y); \
+	return fixed_lt(x->array, y->array, (bits) / WORD_BIT); \
+} \
+\
+void aui##bits##_shl(struct aui##bits *x, size_t shift) \
+{ \
+	assert(x); \
+	fixed_shl(x->array, (bits) / WORD_BIT, shift); \
+	return; \
+} \
+\
+void aui##bits##_shr(struct aui##bits *x, size_t shift) \
+{ \
+	assert(x); \
+	fixed_shr(x->array, (bits) / WORD_BIT, shift); \
+	return; \
+} \
+\
+void aui##bits##_add(struct aui##bits *x, const struct aui##bits *y) \
+{ \
+	assert(x); \
+	assert(y); \
+	fixed_add(x->array, y->array, (bits) / WORD_BIT); \
+	return; \
+} \
+\
+void aui##bits##_sub(struct aui##bits *x, const struct aui##bits *y) \
+{ \
+	assert(x); \
+	assert(y); \
+	fixed_sub(x->array, y->array, (bits) / WORD_BIT); \
+	return; \
+} \
+\
+void aui##bits##_mul(struct aui##bits *x, const struct aui##bits *y) \
+{ \
+	word r[(bits) / WORD_BIT]; \
+\
+	assert(x); \
+	assert(y); \
+	fixed_mul(r, x->array, y->array, (bits) / WORD_BIT); \
+	return; \
 }
+
+FIXED(128)
+FIXED(256)
+FIXED(512)
+FIXED(1024)
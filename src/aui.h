@@ -12,38 +12,118 @@
 #include <limits.h>
 #include <stddef.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef AUI_TYPE
 #define AUI_TYPE unsigned char
 #define AUI_TYPE_BIT CHAR_BIT
 #define AUI_TYPE_MAX UCHAR_MAX
+#endif
 #define AUI_SIZTOLEN(size) \
-	((size) / sizeof(AUI_TYPE) + !!((size) % sizeof(AUI_TYPE)))
+	((size_t)(size) / sizeof(AUI_TYPE) + !!((size_t)(size) % sizeof(AUI_TYPE)))
+#define AUI_LENGTH_MAX ((size_t)-1 / AUI_TYPE_BIT)
+#define AUI_NONE ((size_t)-1)
+
+/* word and byte orders for aui_import() and aui_export() */
+#define AUI_BIG 1
+#define AUI_LITTLE (-1)
+#define AUI_NATIVE 0
 
 struct aui {
 	AUI_TYPE *array;
-	unsigned int length;
+	size_t length;
 	struct aui *next;
+	int view; /* the array is borrowed, see aui_view() */
+};
+
+struct aui_vector {
+	AUI_TYPE *array;
+	size_t length;
+	size_t count;
+};
+
+/* fixed-width integers, stored inline; AUI_FIXED(128) declares struct aui128 and its functions */
+#define AUI_FIXED(bits) \
+	struct aui##bits { \
+		AUI_TYPE array[AUI_SIZTOLEN((bits) / CHAR_BIT)]; \
+	}; \
+	void aui##bits##_seti(struct aui##bits *x, unsigned long value); \
+	unsigned long aui##bits##_geti(const struct aui##bits *x); \
+	void aui##bits##_get(struct aui *x, const struct aui##bits *y); \
+	void aui##bits##_set(struct aui##bits *x, const struct aui *y); \
+	int aui##bits##_eq(const struct aui##bits *x, const struct aui##bits *y); \
+	int aui##bits##_lt(const struct aui##bits *x, const struct aui##bits *y); \
+	void aui##bits##_shl(struct aui##bits *x, size_t shift); \
+	void aui##bits##_shr(struct aui##bits *x, size_t shift); \
+	void aui##bits##_add(struct aui##bits *x, const struct aui##bits *y); \
+	void aui##bits##_sub(struct aui##bits *x, const struct aui##bits *y); \
+	void aui##bits##_mul(struct aui##bits *x, const struct aui##bits *y);
+
+/* the state of a streaming aui_hash(); see aui_hash_init() */
+struct aui_hash_state {
+	unsigned long acc[8];
+	unsigned long key[8];
+	unsigned long buffer[8];
+	unsigned long seed;
+	size_t fill;
+	size_t stripes;
+	size_t total;
+	size_t zeros;
 };
 
-void aui_init(void);
+struct aui_index {
+	const struct aui *x;
+	size_t *count;
+	size_t blocks;
+};
 
 AUI_TYPE aui_msbn(AUI_TYPE native);
 AUI_TYPE aui_lsbn(AUI_TYPE native);
 
-unsigned long aui_msba(const struct aui *x);
-unsigned long aui_lsba(const struct aui *x);
+size_t aui_msba(const struct aui *x);
+size_t aui_lsba(const struct aui *x);
+size_t aui_nextbit(const struct aui *x, size_t from);
+size_t aui_prevbit(const struct aui *x, size_t from);
+size_t aui_listbits(const struct aui *x, size_t from, size_t *bits, size_t size);
+
+size_t aui_popcount(const struct aui *x);
+size_t aui_hamming(const struct aui *x, const struct aui *y);
 
-struct aui *aui_alloc(unsigned int length);
+unsigned long aui_hash(const struct aui *x, unsigned long seed);
+void aui_hash_init(struct aui_hash_state *state, unsigned long seed);
+void aui_hash_update(struct aui_hash_state *state, const struct aui *x);
+unsigned long aui_hash_final(const struct aui_hash_state *state);
+
+int aui_testbit(const struct aui *x, size_t bit);
+void aui_setbit(struct aui *x, size_t bit);
+void aui_clrbit(struct aui *x, size_t bit);
+void aui_flipbit(struct aui *x, size_t bit);
+unsigned long aui_getbits(const struct aui *x, size_t bit, unsigned int count);
+void aui_setbits(struct aui *x, size_t bit, unsigned int count, unsigned long value);
+
+struct aui_index *aui_index_alloc(const struct aui *x);
+void aui_index_free(struct aui_index *index);
+void aui_index_build(struct aui_index *index);
+size_t aui_rank(const struct aui_index *index, size_t bit);
+size_t aui_select(const struct aui_index *index, size_t k);
+
+struct aui *aui_alloc(size_t length);
+struct aui *aui_view(const AUI_TYPE *array, size_t length);
 void aui_free(struct aui *x);
 
-struct aui *aui_pull(unsigned int length);
+struct aui *aui_pull(size_t length);
 void aui_push(struct aui *x);
 void aui_wipe(void);
 
 void aui_seti(struct aui *x, unsigned long value);
 int aui_sets(struct aui *x, const char *string, const char *set, int base);
+void aui_import(struct aui *x, const void *data, size_t count, size_t size, int order, int endian);
 
 unsigned long aui_geti(const struct aui *x);
 int aui_gets(char *string, size_t size, const char *set, int base, const struct aui *x);
+size_t aui_export(void *data, size_t count, size_t size, int order, int endian, const struct aui *x);
 
 void aui_asgn(struct aui *x, const struct aui *y);
 void aui_swap(struct aui *x, struct aui *y);
@@ -54,15 +134,19 @@ int aui_lt(const struct aui *x, const struct aui *y);
 int aui_lte(const struct aui *x, const struct aui *y);
 int aui_gt(const struct aui *x, const struct aui *y);
 int aui_gte(const struct aui *x, const struct aui *y);
+int aui_cmp(const struct aui *x, const struct aui *y);
 int aui_eval(const struct aui *x);
+int aui_sort(struct aui **x, size_t count);
 
 void aui_one(struct aui *x);
 void aui_two(struct aui *x);
 void aui_and(struct aui *x, const struct aui *y);
 void aui_ior(struct aui *x, const struct aui *y);
 void aui_xor(struct aui *x, const struct aui *y);
-void aui_shl(struct aui *x, unsigned long shift);
-void aui_shr(struct aui *x, unsigned long shift);
+void aui_shl(struct aui *x, size_t shift);
+void aui_shr(struct aui *x, size_t shift);
+
+unsigned int aui_threads(unsigned int count);
 
 void aui_inc(struct aui *x);
 void aui_dec(struct aui *x);
@@ -72,4 +156,47 @@ int aui_mul(struct aui *x, const struct aui *y);
 int aui_div(struct aui *x, const struct aui *y);
 int aui_mod(struct aui *x, const struct aui *y);
 
+int aui_add3(struct aui *r, const struct aui *x, const struct aui *y);
+int aui_sub3(struct aui *r, const struct aui *x, const struct aui *y);
+int aui_mul3(struct aui *r, const struct aui *x, const struct aui *y);
+int aui_div3(struct aui *r, const struct aui *x, const struct aui *y);
+int aui_mod3(struct aui *r, const struct aui *x, const struct aui *y);
+void aui_and3(struct aui *r, const struct aui *x, const struct aui *y);
+void aui_ior3(struct aui *r, const struct aui *x, const struct aui *y);
+void aui_xor3(struct aui *r, const struct aui *x, const struct aui *y);
+
+AUI_TYPE aui_addc(struct aui *x, const struct aui *y, AUI_TYPE carry);
+AUI_TYPE aui_subc(struct aui *x, const struct aui *y, AUI_TYPE borrow);
+AUI_TYPE aui_shlc(struct aui *x, size_t shift, AUI_TYPE carry);
+
+int aui_addmul(struct aui *x, const struct aui *y, const struct aui *z);
+int aui_submul(struct aui *x, const struct aui *y, const struct aui *z);
+int aui_addshl(struct aui *x, const struct aui *y, size_t shift);
+int aui_subshl(struct aui *x, const struct aui *y, size_t shift);
+
+int aui_add_batch(struct aui *x, const struct aui *y, size_t count);
+int aui_sub_batch(struct aui *x, const struct aui *y, size_t count);
+int aui_mul_batch(struct aui *x, const struct aui *y, size_t count);
+
+struct aui_vector *aui_vector_alloc(size_t length, size_t count);
+void aui_vector_free(struct aui_vector *x);
+void aui_vector_get(struct aui *x, const struct aui_vector *y, size_t index);
+void aui_vector_set(struct aui_vector *x, size_t index, const struct aui *y);
+void aui_vector_add(struct aui_vector *x, const struct aui_vector *y);
+void aui_vector_sub(struct aui_vector *x, const struct aui_vector *y);
+void aui_vector_and(struct aui_vector *x, const struct aui_vector *y);
+void aui_vector_ior(struct aui_vector *x, const struct aui_vector *y);
+void aui_vector_xor(struct aui_vector *x, const struct aui_vector *y);
+void aui_vector_eq(unsigned char *result, const struct aui_vector *x, const struct aui_vector *y);
+void aui_vector_lt(unsigned char *result, const struct aui_vector *x, const struct aui_vector *y);
+
+AUI_FIXED(128)
+AUI_FIXED(256)
+AUI_FIXED(512)
+AUI_FIXED(1024)
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
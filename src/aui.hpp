@@ -0,0 +1,1241 @@
+/*
+ * aui.hpp
+ * 2026-10-19
+ *
+ * Arbitrary unsigned integer library, C++ interface
+ * Copyright (c) 2018 Johan Palm <johan@pij.se>
+ * Published under the MIT license.
+ */
+
+#ifndef AUI_HPP
+#define AUI_HPP
+#include "aui.h"
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/* the namespace can't be aui, which names struct aui */
+namespace auipp {
+
+namespace expr {
+
+/* the base of the expression nodes */
+struct node {
+};
+
+template <class E>
+using if_node = typename std::enable_if<std::is_base_of<node, E>::value>::type;
+
+}
+
+/*
+ * Owns a struct aui pulled from the list and pushes it back when destroyed.
+ * Moves steal the pointer and leave the source empty, except that moving
+ * into or out of a view copies the limbs; copies are explicit, through
+ * copy() or assign(). The operators map onto the destructive aui_*
+ * functions, so the result has the length of the left operand.
+ */
+class integer {
+public:
+	explicit integer(std::size_t length, unsigned long value = 0)
+		: x(aui_pull(length))
+	{
+		if (!x)
+			throw std::bad_alloc();
+		aui_seti(x, value);
+	}
+
+	/* takes ownership of x, which must come from aui_pull(), aui_alloc() or aui_view() */
+	explicit integer(struct aui *x) noexcept
+		: x(x)
+	{
+	}
+
+	integer(integer &&y) noexcept
+		: x(y.x)
+	{
+		y.x = nullptr;
+	}
+
+	integer(const integer &) = delete;
+
+	~integer()
+	{
+		if (x)
+			aui_push(x);
+	}
+
+	/* a view keeps its array, so assigning to or from one copies the limbs */
+	integer &operator=(integer &&y) noexcept
+	{
+		if (x && y.x && (x->view || y.x->view))
+			aui_asgn(x, y.x);
+		else
+			std::swap(x, y.x);
+		return *this;
+	}
+
+	integer &operator=(const integer &) = delete;
+
+	integer &operator=(unsigned long value)
+	{
+		aui_seti(x, value);
+		return *this;
+	}
+
+	/* an integer of the given length with the value of the expression e */
+	template <class E, class = expr::if_node<E>>
+	integer(std::size_t length, const E &e);
+
+	/* evaluates e into *this, at the length of *this */
+	template <class E, class = expr::if_node<E>>
+	integer &operator=(const E &e);
+
+	/* a new integer of the same length and value */
+	integer copy() const
+	{
+		integer y(x->length);
+
+		aui_asgn(y.x, x);
+		return y;
+	}
+
+	/* *this = y, keeping the length of *this */
+	integer &assign(const integer &y)
+	{
+		aui_asgn(x, y.x);
+		return *this;
+	}
+
+	void swap(integer &y) noexcept
+	{
+		std::swap(x, y.x);
+	}
+
+	/* gives up ownership; the caller frees or pushes the result */
+	struct aui *release() noexcept
+	{
+		struct aui *y;
+
+		y = x;
+		x = nullptr;
+		return y;
+	}
+
+	struct aui *get() noexcept
+	{
+		return x;
+	}
+
+	const struct aui *get() const noexcept
+	{
+		return x;
+	}
+
+	std::size_t length() const noexcept
+	{
+		return x->length;
+	}
+
+	explicit operator bool() const
+	{
+		return aui_eval(x);
+	}
+
+	unsigned long geti() const
+	{
+		return aui_geti(x);
+	}
+
+	void sets(const char *string, const char *set = "0123456789", int base = 10)
+	{
+		if (!aui_sets(x, string, set, base))
+			throw std::bad_alloc();
+	}
+
+	std::string gets(const char *set = "0123456789", int base = 10) const
+	{
+		std::string string;
+		std::size_t size;
+
+		/* at least one digit per bit, and the terminating null character */
+		size = x->length * AUI_TYPE_BIT + 2;
+		string.resize(size);
+		if (!aui_gets(&string[0], size, set, base, x))
+			throw std::bad_alloc();
+		string.resize(string.find('\0'));
+		return string;
+	}
+
+	integer &operator+=(const integer &y)
+	{
+		check(aui_add(x, y.x));
+		return *this;
+	}
+
+	integer &operator-=(const integer &y)
+	{
+		check(aui_sub(x, y.x));
+		return *this;
+	}
+
+	integer &operator*=(const integer &y)
+	{
+		check(aui_mul(x, y.x));
+		return *this;
+	}
+
+	integer &operator/=(const integer &y)
+	{
+		check(divide(x, x, y.x));
+		return *this;
+	}
+
+	integer &operator%=(const integer &y)
+	{
+		check(modulo(x, x, y.x));
+		return *this;
+	}
+
+	integer &operator&=(const integer &y)
+	{
+		aui_and(x, y.x);
+		return *this;
+	}
+
+	integer &operator|=(const integer &y)
+	{
+		aui_ior(x, y.x);
+		return *this;
+	}
+
+	integer &operator^=(const integer &y)
+	{
+		aui_xor(x, y.x);
+		return *this;
+	}
+
+	integer &operator<<=(std::size_t shift)
+	{
+		aui_shl(x, shift);
+		return *this;
+	}
+
+	integer &operator>>=(std::size_t shift)
+	{
+		aui_shr(x, shift);
+		return *this;
+	}
+
+	template <class E, class = expr::if_node<E>>
+	integer &operator+=(const E &e);
+	template <class E, class = expr::if_node<E>>
+	integer &operator-=(const E &e);
+	template <class E, class = expr::if_node<E>>
+	integer &operator*=(const E &e);
+	template <class E, class = expr::if_node<E>>
+	integer &operator/=(const E &e);
+	template <class E, class = expr::if_node<E>>
+	integer &operator%=(const E &e);
+	template <class E, class = expr::if_node<E>>
+	integer &operator&=(const E &e);
+	template <class E, class = expr::if_node<E>>
+	integer &operator|=(const E &e);
+	template <class E, class = expr::if_node<E>>
+	integer &operator^=(const E &e);
+
+	integer &operator++()
+	{
+		aui_inc(x);
+		return *this;
+	}
+
+	integer &operator--()
+	{
+		aui_dec(x);
+		return *this;
+	}
+
+	friend bool operator==(const integer &x, const integer &y)
+	{
+		return aui_eq(x.x, y.x);
+	}
+
+	friend bool operator!=(const integer &x, const integer &y)
+	{
+		return aui_neq(x.x, y.x);
+	}
+
+	friend bool operator<(const integer &x, const integer &y)
+	{
+		return aui_lt(x.x, y.x);
+	}
+
+	friend bool operator<=(const integer &x, const integer &y)
+	{
+		return aui_lte(x.x, y.x);
+	}
+
+	friend bool operator>(const integer &x, const integer &y)
+	{
+		return aui_gt(x.x, y.x);
+	}
+
+	friend bool operator>=(const integer &x, const integer &y)
+	{
+		return aui_gte(x.x, y.x);
+	}
+
+	static void check(int result)
+	{
+		if (!result)
+			throw std::bad_alloc();
+	}
+
+	static int divide(struct aui *r, const struct aui *x, const struct aui *y)
+	{
+		if (!aui_eval(y))
+			throw std::domain_error("auipp::integer: division by zero");
+		return aui_div3(r, x, y);
+	}
+
+	static int modulo(struct aui *r, const struct aui *x, const struct aui *y)
+	{
+		if (!aui_eval(y))
+			throw std::domain_error("auipp::integer: division by zero");
+		return aui_mod3(r, x, y);
+	}
+
+private:
+	struct aui *x;
+};
+
+inline void swap(integer &x, integer &y) noexcept
+{
+	x.swap(y);
+}
+
+/*
+ * The binary operators take the left operand by rvalue and reuse it for
+ * the result, so that they never copy: write x.copy() + y to keep x.
+ */
+inline integer operator+(integer &&x, const integer &y)
+{
+	x += y;
+	return std::move(x);
+}
+
+inline integer operator-(integer &&x, const integer &y)
+{
+	x -= y;
+	return std::move(x);
+}
+
+inline integer operator*(integer &&x, const integer &y)
+{
+	x *= y;
+	return std::move(x);
+}
+
+inline integer operator/(integer &&x, const integer &y)
+{
+	x /= y;
+	return std::move(x);
+}
+
+inline integer operator%(integer &&x, const integer &y)
+{
+	x %= y;
+	return std::move(x);
+}
+
+inline integer operator&(integer &&x, const integer &y)
+{
+	x &= y;
+	return std::move(x);
+}
+
+inline integer operator|(integer &&x, const integer &y)
+{
+	x |= y;
+	return std::move(x);
+}
+
+inline integer operator^(integer &&x, const integer &y)
+{
+	x ^= y;
+	return std::move(x);
+}
+
+inline integer operator<<(integer &&x, std::size_t shift)
+{
+	x <<= shift;
+	return std::move(x);
+}
+
+inline integer operator>>(integer &&x, std::size_t shift)
+{
+	x >>= shift;
+	return std::move(x);
+}
+
+/*
+ * Expression templates: with at least one operand an expression or an
+ * lvalue integer, the operators build a tree of references instead of
+ * computing, and assigning the tree to an integer evaluates it in place,
+ * at the length of the destination. Right shifts, divisions and remainders
+ * don't commute with truncation, so their operands are evaluated at the
+ * length of the longest integer in them, and the result truncated once.
+ * Products and left shifts of integers are added or subtracted with the
+ * fused functions, so a * b + c * d needs no temporary; one (pulled from
+ * the list) is needed only for a right operand that is any other expression
+ * and can't be regrouped, when the destination appears on the right, or for
+ * the operands of a right shift, division or remainder longer than the
+ * destination. The trees hold references, so don't keep them past the end
+ * of the statement.
+ */
+namespace expr {
+
+/*
+ * the operations, as tags, computing r = x op y; associative ones may be
+ * regrouped, and modular ones evaluated at the length of the destination
+ */
+struct add {
+	static const bool associative = true;
+	static const bool modular = true;
+	static int apply(struct aui *r, const struct aui *x, const struct aui *y) { return aui_add3(r, x, y); }
+};
+
+struct sub {
+	static const bool associative = false;
+	static const bool modular = true;
+	static int apply(struct aui *r, const struct aui *x, const struct aui *y) { return aui_sub3(r, x, y); }
+};
+
+struct mul {
+	static const bool associative = true;
+	static const bool modular = true;
+	static int apply(struct aui *r, const struct aui *x, const struct aui *y) { return aui_mul3(r, x, y); }
+};
+
+struct div {
+	static const bool associative = false;
+	static const bool modular = false;
+	static int apply(struct aui *r, const struct aui *x, const struct aui *y) { return integer::divide(r, x, y); }
+};
+
+struct mod {
+	static const bool associative = false;
+	static const bool modular = false;
+	static int apply(struct aui *r, const struct aui *x, const struct aui *y) { return integer::modulo(r, x, y); }
+};
+
+struct and_ {
+	static const bool associative = true;
+	static const bool modular = true;
+	static int apply(struct aui *r, const struct aui *x, const struct aui *y) { aui_and3(r, x, y); return 1; }
+};
+
+struct ior {
+	static const bool associative = true;
+	static const bool modular = true;
+	static int apply(struct aui *r, const struct aui *x, const struct aui *y) { aui_ior3(r, x, y); return 1; }
+};
+
+struct xor_ {
+	static const bool associative = true;
+	static const bool modular = true;
+	static int apply(struct aui *r, const struct aui *x, const struct aui *y) { aui_xor3(r, x, y); return 1; }
+};
+
+struct shl {
+};
+
+struct shr {
+};
+
+template <class E>
+using if_operand = typename std::enable_if<std::is_base_of<node, E>::value || std::is_same<E, integer>::value>::type;
+
+/* integers are held by reference, nodes by value */
+template <class E>
+struct held {
+	typedef E type;
+};
+
+template <>
+struct held<integer> {
+	typedef const integer &type;
+};
+
+template <class Op, class L, class R>
+struct binary : node {
+	typename held<L>::type l;
+	typename held<R>::type r;
+
+	binary(const L &l, const R &r)
+		: l(l), r(r)
+	{
+	}
+};
+
+template <class Op, class E>
+struct shift : node {
+	typename held<E>::type e;
+	std::size_t count;
+
+	shift(const E &e, std::size_t count)
+		: e(e), count(count)
+	{
+	}
+};
+
+/* whether the value of e depends on x */
+inline bool refers(const integer &e, const integer &x)
+{
+	return e.get() == x.get();
+}
+
+template <class Op, class L, class R>
+bool refers(const binary<Op, L, R> &e, const integer &x)
+{
+	return refers(e.l, x) || refers(e.r, x);
+}
+
+template <class Op, class E>
+bool refers(const shift<Op, E> &e, const integer &x)
+{
+	return refers(e.e, x);
+}
+
+/* the length of the longest integer in e */
+inline std::size_t width(const integer &e)
+{
+	return e.length();
+}
+
+template <class Op, class L, class R>
+std::size_t width(const binary<Op, L, R> &e)
+{
+	return width(e.l) > width(e.r) ? width(e.l) : width(e.r);
+}
+
+template <class Op, class E>
+std::size_t width(const shift<Op, E> &e)
+{
+	return width(e.e);
+}
+
+/* the length to evaluate e at for x op e: at least all of e unless op is modular */
+template <class Op, class E>
+std::size_t width(Op, const integer &x, const E &e)
+{
+	if (Op::modular || width(e) <= x.length())
+		return x.length();
+	return width(e);
+}
+
+template <class Op, class L, class R>
+void evaluate(integer &x, const binary<Op, L, R> &e);
+template <class Op>
+void evaluate(integer &x, const binary<Op, integer, integer> &e);
+template <class E>
+void evaluate(integer &x, const shift<shl, E> &e);
+template <class E>
+void evaluate(integer &x, const shift<shr, E> &e);
+
+/* x = e, for e not depending on x unless it is x */
+inline void evaluate(integer &x, const integer &e)
+{
+	if (e.get() != x.get())
+		aui_asgn(x.get(), e.get());
+}
+
+/* x = x op e, for e not depending on x */
+template <class Op>
+void apply(Op, integer &x, const integer &e)
+{
+	integer::check(Op::apply(x.get(), x.get(), e.get()));
+}
+
+template <class Op, class E>
+void apply(Op, integer &x, const E &e)
+{
+	integer t(width(Op(), x, e));
+
+	evaluate(t, e);
+	apply(Op(), x, t);
+}
+
+/* x += l * r, x -= l * r, x += l << k and x -= l << k in one pass */
+inline void apply(add, integer &x, const binary<mul, integer, integer> &e)
+{
+	integer::check(aui_addmul(x.get(), e.l.get(), e.r.get()));
+}
+
+inline void apply(sub, integer &x, const binary<mul, integer, integer> &e)
+{
+	integer::check(aui_submul(x.get(), e.l.get(), e.r.get()));
+}
+
+inline void apply(add, integer &x, const shift<shl, integer> &e)
+{
+	integer::check(aui_addshl(x.get(), e.e.get(), e.count));
+}
+
+inline void apply(sub, integer &x, const shift<shl, integer> &e)
+{
+	integer::check(aui_subshl(x.get(), e.e.get(), e.count));
+}
+
+/* x op (l op r) = (x op l) op r */
+template <class Op, class L, class R>
+typename std::enable_if<Op::associative>::type apply(Op, integer &x, const binary<Op, L, R> &e)
+{
+	apply(Op(), x, e.l);
+	apply(Op(), x, e.r);
+}
+
+/* x - (l + r) = x - l - r, x + (l - r) = x + l - r, x - (l - r) = x - l + r */
+template <class L, class R>
+void apply(sub, integer &x, const binary<add, L, R> &e)
+{
+	apply(sub(), x, e.l);
+	apply(sub(), x, e.r);
+}
+
+template <class L, class R>
+void apply(add, integer &x, const binary<sub, L, R> &e)
+{
+	apply(add(), x, e.l);
+	apply(sub(), x, e.r);
+}
+
+template <class L, class R>
+void apply(sub, integer &x, const binary<sub, L, R> &e)
+{
+	apply(sub(), x, e.l);
+	apply(add(), x, e.r);
+}
+
+template <class Op, class L, class R>
+void evaluate(integer &x, const binary<Op, L, R> &e)
+{
+	if (width(Op(), x, e) > x.length()) {
+		integer t(width(e));
+
+		evaluate(t, e);
+		aui_asgn(x.get(), t.get());
+	} else if (!refers(e.r, x)) {
+		evaluate(x, e.l);
+		apply(Op(), x, e.r);
+	} else {
+		integer t(x.length());
+
+		evaluate(t, e);
+		aui_swap(x.get(), t.get());
+	}
+}
+
+/* x = l op r straight from the operands, which may include x */
+template <class Op>
+void evaluate(integer &x, const binary<Op, integer, integer> &e)
+{
+	integer::check(Op::apply(x.get(), e.l.get(), e.r.get()));
+}
+
+template <class E>
+void evaluate(integer &x, const shift<shl, E> &e)
+{
+	evaluate(x, e.e);
+	aui_shl(x.get(), e.count);
+}
+
+template <class E>
+void evaluate(integer &x, const shift<shr, E> &e)
+{
+	if (width(e) > x.length()) {
+		integer t(width(e));
+
+		evaluate(t, e.e);
+		aui_shr(t.get(), e.count);
+		aui_asgn(x.get(), t.get());
+	} else {
+		evaluate(x, e.e);
+		aui_shr(x.get(), e.count);
+	}
+}
+
+/* x op= e, where e may depend on x */
+template <class Op, class E>
+void assign(Op, integer &x, const E &e)
+{
+	if (refers(e, x)) {
+		integer t(width(Op(), x, e));
+
+		evaluate(t, e);
+		apply(Op(), x, t);
+	} else {
+		apply(Op(), x, e);
+	}
+}
+
+}
+
+template <class E, class>
+integer::integer(std::size_t length, const E &e)
+	: integer(length)
+{
+	expr::evaluate(*this, e);
+}
+
+template <class E, class>
+integer &integer::operator=(const E &e)
+{
+	expr::evaluate(*this, e);
+	return *this;
+}
+
+template <class E, class>
+integer &integer::operator+=(const E &e)
+{
+	expr::assign(expr::add(), *this, e);
+	return *this;
+}
+
+template <class E, class>
+integer &integer::operator-=(const E &e)
+{
+	expr::assign(expr::sub(), *this, e);
+	return *this;
+}
+
+template <class E, class>
+integer &integer::operator*=(const E &e)
+{
+	expr::assign(expr::mul(), *this, e);
+	return *this;
+}
+
+template <class E, class>
+integer &integer::operator/=(const E &e)
+{
+	expr::assign(expr::div(), *this, e);
+	return *this;
+}
+
+template <class E, class>
+integer &integer::operator%=(const E &e)
+{
+	expr::assign(expr::mod(), *this, e);
+	return *this;
+}
+
+template <class E, class>
+integer &integer::operator&=(const E &e)
+{
+	expr::assign(expr::and_(), *this, e);
+	return *this;
+}
+
+template <class E, class>
+integer &integer::operator|=(const E &e)
+{
+	expr::assign(expr::ior(), *this, e);
+	return *this;
+}
+
+template <class E, class>
+integer &integer::operator^=(const E &e)
+{
+	expr::assign(expr::xor_(), *this, e);
+	return *this;
+}
+
+template <class L, class R, class = expr::if_operand<L>, class = expr::if_operand<R>>
+expr::binary<expr::add, L, R> operator+(const L &l, const R &r)
+{
+	return expr::binary<expr::add, L, R>(l, r);
+}
+
+template <class L, class R, class = expr::if_operand<L>, class = expr::if_operand<R>>
+expr::binary<expr::sub, L, R> operator-(const L &l, const R &r)
+{
+	return expr::binary<expr::sub, L, R>(l, r);
+}
+
+template <class L, class R, class = expr::if_operand<L>, class = expr::if_operand<R>>
+expr::binary<expr::mul, L, R> operator*(const L &l, const R &r)
+{
+	return expr::binary<expr::mul, L, R>(l, r);
+}
+
+template <class L, class R, class = expr::if_operand<L>, class = expr::if_operand<R>>
+expr::binary<expr::div, L, R> operator/(const L &l, const R &r)
+{
+	return expr::binary<expr::div, L, R>(l, r);
+}
+
+template <class L, class R, class = expr::if_operand<L>, class = expr::if_operand<R>>
+expr::binary<expr::mod, L, R> operator%(const L &l, const R &r)
+{
+	return expr::binary<expr::mod, L, R>(l, r);
+}
+
+template <class L, class R, class = expr::if_operand<L>, class = expr::if_operand<R>>
+expr::binary<expr::and_, L, R> operator&(const L &l, const R &r)
+{
+	return expr::binary<expr::and_, L, R>(l, r);
+}
+
+template <class L, class R, class = expr::if_operand<L>, class = expr::if_operand<R>>
+expr::binary<expr::ior, L, R> operator|(const L &l, const R &r)
+{
+	return expr::binary<expr::ior, L, R>(l, r);
+}
+
+template <class L, class R, class = expr::if_operand<L>, class = expr::if_operand<R>>
+expr::binary<expr::xor_, L, R> operator^(const L &l, const R &r)
+{
+	return expr::binary<expr::xor_, L, R>(l, r);
+}
+
+template <class E, class = expr::if_operand<E>>
+expr::shift<expr::shl, E> operator<<(const E &e, std::size_t count)
+{
+	return expr::shift<expr::shl, E>(e, count);
+}
+
+template <class E, class = expr::if_operand<E>>
+expr::shift<expr::shr, E> operator>>(const E &e, std::size_t count)
+{
+	return expr::shift<expr::shr, E>(e, count);
+}
+
+#if __cplusplus >= 201402L
+/*
+ * A Bits-bit integer whose operations are constexpr (C++14), so that
+ * constant tables can be computed at compile time and placed in read-only
+ * memory. The limbs are laid out as in struct aui128 and the other fixed
+ * widths, least significant first, and the algorithms are those of the C
+ * kernels, written again here as C can't be evaluated at compile time:
+ * carry and borrow chains, schoolbook multiplication through the half-limb
+ * mul_ll(), and shift-and-subtract division. Arithmetic is modulo 2^Bits.
+ */
+template <std::size_t Bits>
+class fixed {
+	static_assert(Bits && !(Bits % AUI_TYPE_BIT), "auipp::fixed: Bits must be a multiple of AUI_TYPE_BIT");
+
+public:
+	static constexpr std::size_t length = Bits / AUI_TYPE_BIT;
+
+	AUI_TYPE array[length];
+
+	constexpr fixed() noexcept
+		: array{}
+	{
+	}
+
+	constexpr fixed(unsigned long value) noexcept
+		: array{}
+	{
+		std::size_t i = 0;
+
+		while ((i < length) && (i < (sizeof(value) / sizeof(AUI_TYPE)))) {
+			array[i] = value >> (AUI_TYPE_BIT * i);
+			i++;
+		}
+	}
+
+	/* as aui_sets(), up to the first character not in the first base characters of set */
+	static constexpr fixed parse(const char *string, const char *set = "0123456789", int base = 10)
+	{
+		fixed x;
+		int digit = 0;
+
+		while (*string) {
+			digit = 0;
+			while ((digit < base) && (set[digit] != *string))
+				digit++;
+			if (digit == base)
+				break;
+			x.muladd(base, digit);
+			string++;
+		}
+		return x;
+	}
+
+	constexpr unsigned long geti() const noexcept
+	{
+		unsigned long value = 0;
+		std::size_t i = (length < (sizeof(value) / sizeof(AUI_TYPE))) ? length : (sizeof(value) / sizeof(AUI_TYPE));
+
+		while (i--)
+			value |= (unsigned long)array[i] << (AUI_TYPE_BIT * i);
+		return value;
+	}
+
+	/* x = *this, for the C functions */
+	void get(struct aui *x) const
+	{
+		struct aui y = {const_cast<AUI_TYPE *>(array), length, nullptr, 0};
+
+		aui_asgn(x, &y);
+	}
+
+	/* *this = x, truncated to Bits bits */
+	void set(const struct aui *x)
+	{
+		struct aui y = {array, length, nullptr, 0};
+
+		aui_asgn(&y, x);
+	}
+
+	std::string gets(const char *set = "0123456789", int base = 10) const
+	{
+		struct aui x = {const_cast<AUI_TYPE *>(array), length, nullptr, 0};
+		std::string string;
+		std::size_t size;
+
+		size = Bits + 2;
+		string.resize(size);
+		if (!aui_gets(&string[0], size, set, base, &x))
+			throw std::bad_alloc();
+		string.resize(string.find('\0'));
+		return string;
+	}
+
+	constexpr explicit operator bool() const noexcept
+	{
+		std::size_t i = 0;
+
+		while (i < length)
+			if (array[i++])
+				return true;
+		return false;
+	}
+
+	constexpr fixed &operator+=(const fixed &y) noexcept
+	{
+		AUI_TYPE carry = 0;
+		std::size_t i = 0;
+
+		while (i < length) {
+			AUI_TYPE sum = array[i] + carry;
+
+			carry = sum < carry;
+			array[i] = sum + y.array[i];
+			carry += array[i] < sum;
+			i++;
+		}
+		return *this;
+	}
+
+	constexpr fixed &operator-=(const fixed &y) noexcept
+	{
+		AUI_TYPE borrow = 0;
+		std::size_t i = 0;
+
+		while (i < length) {
+			AUI_TYPE difference = array[i] - borrow;
+
+			borrow = difference > array[i];
+			array[i] = difference - y.array[i];
+			borrow += array[i] > difference;
+			i++;
+		}
+		return *this;
+	}
+
+	constexpr fixed &operator*=(const fixed &y) noexcept
+	{
+		fixed r;
+		std::size_t i = 0;
+		std::size_t j = 0;
+
+		while (i < length) {
+			AUI_TYPE carry = 0;
+
+			j = 0;
+			while (i + j < length) {
+				AUI_TYPE hi = 0;
+				AUI_TYPE lo = mul_ll(hi, array[i], y.array[j]);
+
+				lo += carry;
+				hi += lo < carry;
+				r.array[i + j] += lo;
+				hi += r.array[i + j] < lo;
+				carry = hi;
+				j++;
+			}
+			i++;
+		}
+		return *this = r;
+	}
+
+	constexpr fixed &operator/=(const fixed &y)
+	{
+		divmod(y);
+		return *this;
+	}
+
+	constexpr fixed &operator%=(const fixed &y)
+	{
+		return *this = divmod(y);
+	}
+
+	constexpr fixed &operator&=(const fixed &y) noexcept
+	{
+		std::size_t i = 0;
+
+		while (i < length) {
+			array[i] &= y.array[i];
+			i++;
+		}
+		return *this;
+	}
+
+	constexpr fixed &operator|=(const fixed &y) noexcept
+	{
+		std::size_t i = 0;
+
+		while (i < length) {
+			array[i] |= y.array[i];
+			i++;
+		}
+		return *this;
+	}
+
+	constexpr fixed &operator^=(const fixed &y) noexcept
+	{
+		std::size_t i = 0;
+
+		while (i < length) {
+			array[i] ^= y.array[i];
+			i++;
+		}
+		return *this;
+	}
+
+	constexpr fixed &operator<<=(std::size_t shift) noexcept
+	{
+		std::size_t limbs = (shift < Bits) ? (shift / AUI_TYPE_BIT) : length;
+		std::size_t bits = shift % AUI_TYPE_BIT;
+		std::size_t i = length;
+
+		while (i-- > limbs) {
+			array[i] = array[i - limbs] << bits;
+			if (bits && (i > limbs))
+				array[i] |= array[i - limbs - 1] >> (AUI_TYPE_BIT - bits);
+		}
+		while (limbs--)
+			array[limbs] = 0;
+		return *this;
+	}
+
+	constexpr fixed &operator>>=(std::size_t shift) noexcept
+	{
+		std::size_t limbs = (shift < Bits) ? (shift / AUI_TYPE_BIT) : length;
+		std::size_t bits = shift % AUI_TYPE_BIT;
+		std::size_t i = 0;
+
+		while (i + limbs < length) {
+			array[i] = array[i + limbs] >> bits;
+			if (bits && (i + limbs + 1 < length))
+				array[i] |= array[i + limbs + 1] << (AUI_TYPE_BIT - bits);
+			i++;
+		}
+		while (i < length)
+			array[i++] = 0;
+		return *this;
+	}
+
+	constexpr fixed &operator++() noexcept
+	{
+		std::size_t i = 0;
+
+		while ((i < length) && !++array[i])
+			i++;
+		return *this;
+	}
+
+	constexpr fixed &operator--() noexcept
+	{
+		std::size_t i = 0;
+
+		while ((i < length) && !array[i]--)
+			i++;
+		return *this;
+	}
+
+	friend constexpr fixed operator+(fixed x, const fixed &y) noexcept
+	{
+		return x += y;
+	}
+
+	friend constexpr fixed operator-(fixed x, const fixed &y) noexcept
+	{
+		return x -= y;
+	}
+
+	friend constexpr fixed operator*(fixed x, const fixed &y) noexcept
+	{
+		return x *= y;
+	}
+
+	friend constexpr fixed operator/(fixed x, const fixed &y)
+	{
+		return x /= y;
+	}
+
+	friend constexpr fixed operator%(fixed x, const fixed &y)
+	{
+		return x %= y;
+	}
+
+	friend constexpr fixed operator&(fixed x, const fixed &y) noexcept
+	{
+		return x &= y;
+	}
+
+	friend constexpr fixed operator|(fixed x, const fixed &y) noexcept
+	{
+		return x |= y;
+	}
+
+	friend constexpr fixed operator^(fixed x, const fixed &y) noexcept
+	{
+		return x ^= y;
+	}
+
+	friend constexpr fixed operator<<(fixed x, std::size_t shift) noexcept
+	{
+		return x <<= shift;
+	}
+
+	friend constexpr fixed operator>>(fixed x, std::size_t shift) noexcept
+	{
+		return x >>= shift;
+	}
+
+	friend constexpr bool operator==(const fixed &x, const fixed &y) noexcept
+	{
+		std::size_t i = 0;
+
+		while (i < length) {
+			if (x.array[i] != y.array[i])
+				return false;
+			i++;
+		}
+		return true;
+	}
+
+	friend constexpr bool operator!=(const fixed &x, const fixed &y) noexcept
+	{
+		return !(x == y);
+	}
+
+	friend constexpr bool operator<(const fixed &x, const fixed &y) noexcept
+	{
+		std::size_t i = length;
+
+		while (i--)
+			if (x.array[i] != y.array[i])
+				return x.array[i] < y.array[i];
+		return false;
+	}
+
+	friend constexpr bool operator<=(const fixed &x, const fixed &y) noexcept
+	{
+		return !(y < x);
+	}
+
+	friend constexpr bool operator>(const fixed &x, const fixed &y) noexcept
+	{
+		return y < x;
+	}
+
+	friend constexpr bool operator>=(const fixed &x, const fixed &y) noexcept
+	{
+		return !(x < y);
+	}
+
+private:
+	/* x * y as a double limb, in half limbs as mul_ll() in aui.c does without a wider type */
+	static constexpr AUI_TYPE mul_ll(AUI_TYPE &hi, AUI_TYPE x, AUI_TYPE y) noexcept
+	{
+		AUI_TYPE mask = AUI_TYPE_MAX >> (AUI_TYPE_BIT / 2);
+		AUI_TYPE ll = (AUI_TYPE)(x & mask) * (AUI_TYPE)(y & mask);
+		AUI_TYPE lh = (AUI_TYPE)(x & mask) * (AUI_TYPE)(y >> (AUI_TYPE_BIT / 2));
+		AUI_TYPE hl = (AUI_TYPE)(x >> (AUI_TYPE_BIT / 2)) * (AUI_TYPE)(y & mask);
+		AUI_TYPE middle = (ll >> (AUI_TYPE_BIT / 2)) + (lh & mask) + (hl & mask);
+
+		hi = (AUI_TYPE)(x >> (AUI_TYPE_BIT / 2)) * (AUI_TYPE)(y >> (AUI_TYPE_BIT / 2))
+			+ (lh >> (AUI_TYPE_BIT / 2)) + (hl >> (AUI_TYPE_BIT / 2))
+			+ (middle >> (AUI_TYPE_BIT / 2));
+		return (AUI_TYPE)(middle << (AUI_TYPE_BIT / 2)) | (ll & mask);
+	}
+
+	/* *this = *this * y + carry, as mul_1() */
+	constexpr void muladd(AUI_TYPE y, AUI_TYPE carry) noexcept
+	{
+		std::size_t i = 0;
+
+		while (i < length) {
+			AUI_TYPE hi = 0;
+			AUI_TYPE lo = mul_ll(hi, array[i], y);
+
+			array[i] = lo + carry;
+			carry = hi + (array[i] < lo);
+			i++;
+		}
+	}
+
+	/* *this /= y, returning the remainder */
+	constexpr fixed divmod(const fixed &y)
+	{
+		fixed q;
+		fixed r;
+		std::size_t i = Bits;
+		bool top = false;
+
+		if (!y)
+			throw std::domain_error("auipp::fixed: division by zero");
+		while (i--) {
+			top = r.array[length - 1] >> (AUI_TYPE_BIT - 1);
+			r <<= 1;
+			r.array[0] |= (array[i / AUI_TYPE_BIT] >> (i % AUI_TYPE_BIT)) & 1;
+			if (top || !(r < y)) {
+				r -= y;
+				q.array[i / AUI_TYPE_BIT] |= (AUI_TYPE)1 << (i % AUI_TYPE_BIT);
+			}
+		}
+		*this = q;
+		return r;
+	}
+};
+
+template <std::size_t Bits>
+constexpr std::size_t fixed<Bits>::length;
+#endif
+
+}
+
+namespace std {
+
+/* equal integers hash equally whatever their lengths, so they can key unordered containers */
+template <>
+struct hash<auipp::integer> {
+	std::size_t operator()(const auipp::integer &x) const noexcept
+	{
+		return aui_hash(x.get(), 0);
+	}
+};
+
+}
+
+#endif
@@ -11,6 +11,8 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 
 unsigned long msb(unsigned long binary)
 {
@@ -36,14 +38,25 @@ unsigned long lsb(unsigned long binary)
 	return i;
 }
 
-void init_msbn_lsbn(void)
+unsigned long pop(unsigned long binary)
+{
+	unsigned long i;
+
+	i = 0;
+	while (binary) {
+		binary &= binary - 1;
+		i++;
+	}
+	return i;
+}
+
+void msbn_lsbn(void)
 {
 	AUI_TYPE i;
 	AUI_TYPE j;
 	AUI_TYPE k;
 
-	printf("init_msbn_lsbn: start\n");
-	aui_init();
+	printf("msbn_lsbn: start\n");
 	i = AUI_TYPE_MAX; /* test all possible values */
 	do {
 		if ((j = aui_msbn(i)) != (k = msb(i)))
@@ -51,7 +64,7 @@ void init_msbn_lsbn(void)
 		if ((j = aui_lsbn(i)) != (k = lsb(i)))
 			printf("aui_lsbn(%u) != lsb(%u): %u != %u\n", i, i, j, k);
 	} while (--i);
-	printf("init_msbn_lsbn: finish\n");
+	printf("msbn_lsbn: finish\n");
 	return;
 }
 
@@ -67,6 +80,10 @@ void alloc_free(void)
 			printf("aui_alloc(%u) == NULL\n", length);
 		aui_free(x);
 	} while (--length);
+	if ((x = aui_alloc(AUI_LENGTH_MAX + 1))) {
+		printf("aui_alloc(AUI_LENGTH_MAX + 1) != NULL\n");
+		aui_free(x);
+	}
 	printf("alloc_free: finish\n");
 	return;
 }
@@ -104,6 +121,74 @@ void pull_push_wipe(void)
 	return;
 }
 
+void view(void)
+{
+	struct aui *v;
+	struct aui *w;
+	struct aui *x;
+	AUI_TYPE buffer[8];
+	unsigned char bytes[8 * sizeof(AUI_TYPE)];
+	size_t i;
+
+	printf("view: start\n");
+	i = 0;
+	while (i < 8) {
+		buffer[i] = (AUI_TYPE)(0x5A + i);
+		i++;
+	}
+	if (!(v = aui_view(buffer, 8)) || !(w = aui_pull(8)) || !(x = aui_pull(8))) {
+		printf("aui_view(...) or aui_pull(...) == NULL\n");
+		return;
+	}
+	/* reads see the buffer as is */
+	i = 0;
+	while (i < 8) {
+		x->array[i] = buffer[i];
+		i++;
+	}
+	if (!aui_eq(v, x) || (aui_msba(v) != aui_msba(x)) || (aui_popcount(v) != aui_popcount(x))
+		|| (aui_export(bytes, sizeof(bytes), 1, AUI_LITTLE, AUI_NATIVE, v) != aui_export(bytes, sizeof(bytes), 1, AUI_LITTLE, AUI_NATIVE, x))) {
+		printf("aui_view(...): read\n");
+		getchar();
+	}
+	/* writes go to the buffer, also through the temporary of an aliased product and a swap */
+	aui_mul(x, x);
+	aui_mul(v, v);
+	if ((v->array != buffer) || !aui_eq(v, x)) {
+		printf("aui_mul(...) [view]\n");
+		getchar();
+	}
+	aui_seti(w, 1234);
+	aui_swap(v, w);
+	if ((v->array != buffer) || (buffer[0] != (AUI_TYPE)1234) || !aui_eq(w, x)) {
+		printf("aui_swap(...) [view]\n");
+		getchar();
+	}
+	aui_swap(w, v);
+	if ((v->array != buffer) || !aui_eq(v, x) || (aui_geti(w) != 1234)) {
+		printf("aui_swap(...) [view]\n");
+		getchar();
+	}
+	/* neither releases the buffer, nor hands it out again */
+	aui_push(v);
+	aui_push(w);
+	aui_push(x);
+	if (!(x = aui_pull(8)) || (x->array == buffer) || !(w = aui_pull(8)) || (w->array == buffer)) {
+		printf("aui_push(...) [view]\n");
+		getchar();
+	}
+	aui_push(w);
+	aui_push(x);
+	if (!(v = aui_view(buffer + 2, 4))) {
+		printf("aui_view(...) == NULL\n");
+		return;
+	}
+	aui_free(v);
+	aui_wipe();
+	printf("view: finish\n");
+	return;
+}
+
 void seti_geti(void)
 {
 	struct aui *x;
@@ -553,16 +638,127 @@ void eq_neq_lt_lte_gt_gte_eval(void)
 	return;
 }
 
+void cmp_sort(void)
+{
+	struct aui *x;
+	struct aui *y;
+	struct aui **xs;
+	unsigned long random;
+	size_t counts[] = {0, 1, 2, 15, 16, 17, 1000, 5000};
+	size_t count;
+	size_t i;
+	size_t j;
+	int expected;
+	int result;
+
+	printf("cmp_sort: start\n");
+	random = 1;
+	/* random lengths 1 to 4, with random high bytes cleared */
+	i = 0;
+	while (i < 10000) {
+		random = random * 1103515245UL + 12345UL;
+		if (!(x = aui_pull(random % 4 + 1)) || !(y = aui_pull(random / 4 % 4 + 1))) {
+			printf("aui_pull(...) == NULL\n");
+			return;
+		}
+		j = 0;
+		while (j < 4 * AUI_TYPE_BIT) {
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(x, j, 8, random >> 8);
+			aui_setbits(y, j, 8, (i & 1) ? random >> 8 : random >> 16);
+			j += 8;
+		}
+		random = random * 1103515245UL + 12345UL;
+		aui_shr(x, random % (4 * AUI_TYPE_BIT));
+		aui_shr(y, (i & 2) ? random / 8 % (4 * AUI_TYPE_BIT) : random % (4 * AUI_TYPE_BIT));
+		expected = aui_lt(x, y) ? -1 : !aui_eq(x, y);
+		if ((result = aui_cmp(x, y)) != expected) {
+			printf("aui_cmp(...) == %d [%d]\n", result, expected);
+			getchar();
+		}
+		if ((result = aui_cmp(y, x)) != -expected) {
+			printf("aui_cmp(...) == %d [%d]\n", result, -expected);
+			getchar();
+		}
+		aui_push(y);
+		aui_push(x);
+		i++;
+	}
+	/* shared prefixes, duplicates and zeros, in lengths 1 to 4 */
+	i = 0;
+	while (i < sizeof(counts) / sizeof(*counts)) {
+		count = counts[i];
+		if (!(xs = malloc(sizeof(*xs) * (count + 1)))) {
+			printf("malloc(...) == NULL\n");
+			return;
+		}
+		j = 0;
+		while (j < count) {
+			random = random * 1103515245UL + 12345UL;
+			if (!(xs[j] = aui_pull(random % 4 + 1))) {
+				printf("aui_pull(...) == NULL\n");
+				return;
+			}
+			aui_seti(xs[j], 0);
+			if (random / 4 % 8) {
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(xs[j], (random >> 8) % (xs[j]->length * AUI_TYPE_BIT), 8, random >> 20);
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(xs[j], 0, 4, random >> 8);
+			}
+			j++;
+		}
+		if (!aui_sort(xs, count)) {
+			printf("aui_sort(...) [%lu] == 0\n", (unsigned long)count);
+			getchar();
+		}
+		j = 0;
+		while (j < count) {
+			if (j && (aui_cmp(xs[j - 1], xs[j]) > 0)) {
+				printf("aui_sort(...) [%lu]: xs[%lu] > xs[%lu]\n", (unsigned long)count, (unsigned long)j - 1, (unsigned long)j);
+				getchar();
+			}
+			j++;
+		}
+		/* mark every integer to check that xs is still a permutation */
+		j = 0;
+		while (j < count) {
+			aui_seti(xs[j], 1);
+			j++;
+		}
+		j = 0;
+		while (j < count) {
+			if (aui_geti(xs[j]) != 1) {
+				printf("aui_sort(...) [%lu]: xs[%lu] repeated\n", (unsigned long)count, (unsigned long)j);
+				getchar();
+			}
+			aui_seti(xs[j], 2);
+			aui_push(xs[j]);
+			j++;
+		}
+		free(xs);
+		i++;
+	}
+	aui_wipe();
+	printf("cmp_sort: finish\n");
+	return;
+}
+
 void msba_lsba(void)
 {
 	struct aui *x;
+	struct aui *y;
+	unsigned long random;
+	size_t length;
+	size_t limb;
+	size_t bit;
+	size_t k;
 	unsigned char i;
 	unsigned short j;
 	unsigned int resulta;
 	unsigned int resultb;
 
 	printf("msba_lsba: start\n");
-	aui_init();
 	/* char */
 	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(i))))) {
 		printf("aui_pull(...) [char] == NULL\n");
@@ -611,15 +807,538 @@ void msba_lsba(void)
 			printf("msba_lsba [short]: %u\n", j);
 	} while (--j);
 	aui_push(x);
+	/* a set or differing limb at every position of integers longer than the vector blocks */
+	random = 1;
+	length = AUI_SIZTOLEN(136);
+	while (length <= AUI_SIZTOLEN(200)) {
+		if (!(x = aui_pull(length)) || !(y = aui_pull(length))) {
+			printf("aui_pull(...) == NULL\n");
+			return;
+		}
+		aui_seti(x, 0);
+		if (aui_eval(x) || (aui_msba(x) != AUI_NONE) || (aui_lsba(x) != AUI_NONE)) {
+			printf("aui_eval/msba/lsba(0) [%lu]\n", (unsigned long)length);
+			getchar();
+		}
+		limb = 0;
+		while (limb < length) {
+			random = random * 1103515245UL + 12345UL;
+			bit = AUI_TYPE_BIT * limb + (random >> 8) % AUI_TYPE_BIT;
+			/* a bit in the limb below it, or in the limb above it, doesn't change the result */
+			aui_seti(x, 0);
+			aui_setbit(x, bit);
+			if (!aui_eval(x) || (aui_msba(x) != bit) || (aui_lsba(x) != bit)) {
+				printf("aui_eval/msba/lsba(...) [%lu]: bit %lu\n", (unsigned long)length, (unsigned long)bit);
+				getchar();
+			}
+			if (limb)
+				aui_setbit(x, bit - AUI_TYPE_BIT);
+			if (aui_msba(x) != bit) {
+				printf("aui_msba(...) [%lu]: bit %lu\n", (unsigned long)length, (unsigned long)bit);
+				getchar();
+			}
+			aui_seti(x, 0);
+			aui_setbit(x, bit);
+			if (limb + 1 < length)
+				aui_setbit(x, bit + AUI_TYPE_BIT);
+			if (aui_lsba(x) != bit) {
+				printf("aui_lsba(...) [%lu]: bit %lu\n", (unsigned long)length, (unsigned long)bit);
+				getchar();
+			}
+			/* x and y differ at limb and, the other way, at a lower limb */
+			k = 0;
+			while (k < length * AUI_TYPE_BIT) {
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(y, k, 8, random >> 8);
+				k += 8;
+			}
+			aui_asgn(x, y);
+			if (!aui_eq(x, y) || aui_lt(x, y)) {
+				printf("aui_eq/lt(...) [%lu]: x != y\n", (unsigned long)length);
+				getchar();
+			}
+			aui_flipbit(x, bit);
+			if (limb)
+				aui_flipbit(x, AUI_TYPE_BIT * (limb / 2) + AUI_TYPE_BIT - 1 - bit % AUI_TYPE_BIT);
+			if (aui_eq(x, y) || (aui_lt(x, y) != !aui_testbit(x, bit)) || (aui_lt(y, x) != aui_testbit(x, bit))) {
+				printf("aui_eq/lt(...) [%lu]: limb %lu\n", (unsigned long)length, (unsigned long)limb);
+				getchar();
+			}
+			limb++;
+		}
+		aui_push(y);
+		aui_push(x);
+		length += AUI_SIZTOLEN(32) + 1;
+	}
 	aui_wipe();
 	printf("msba_lsba: finish\n");
 	return;
 }
 
+void nextbit_prevbit_listbits(void)
+{
+	struct aui *x;
+	size_t *bits;
+	unsigned int length;
+	size_t i;
+	size_t j;
+	size_t count;
+	size_t resulta;
+	size_t resultb;
+
+	printf("nextbit_prevbit_listbits: start\n");
+	length = 1;
+	while (length < 300) {
+		if (!(x = aui_pull(length))) {
+			printf("aui_pull(%u) == NULL\n", length);
+			return;
+		}
+		if (!(bits = malloc(sizeof(*bits) * length * AUI_TYPE_BIT))) {
+			printf("malloc(...) [%u] == NULL\n", length);
+			aui_push(x);
+			aui_wipe();
+			return;
+		}
+		aui_seti(x, 0);
+		i = 0;
+		while (i < length * AUI_TYPE_BIT) {
+			if (!((i * i + length) % 97))
+				aui_setbit(x, i);
+			i++;
+		}
+		count = aui_listbits(x, 0, bits, length * AUI_TYPE_BIT);
+		j = 0;
+		resultb = AUI_NONE;
+		i = 0;
+		while (i < length * AUI_TYPE_BIT + AUI_TYPE_BIT) {
+			if (aui_testbit(x, i)) {
+				if ((j >= count) || (bits[j] != i)) {
+					printf("aui_listbits(...) [%u]: %lu missing\n", length, (unsigned long)i);
+					getchar();
+				}
+				j++;
+				resultb = i;
+			}
+			resulta = aui_prevbit(x, i);
+			if (resulta != resultb) {
+				printf("aui_prevbit(..., %lu) [%u]: %lu != %lu\n", (unsigned long)i, length, (unsigned long)resulta, (unsigned long)resultb);
+				getchar();
+			}
+			i++;
+		}
+		if (j != count) {
+			printf("aui_listbits(...) [%u]: %lu != %lu\n", length, (unsigned long)count, (unsigned long)j);
+			getchar();
+		}
+		resultb = AUI_NONE;
+		while (i--) {
+			if (aui_testbit(x, i))
+				resultb = i;
+			resulta = aui_nextbit(x, i);
+			if (resulta != resultb) {
+				printf("aui_nextbit(..., %lu) [%u]: %lu != %lu\n", (unsigned long)i, length, (unsigned long)resulta, (unsigned long)resultb);
+				getchar();
+			}
+		}
+		i = 0;
+		j = 0;
+		while ((resulta = aui_listbits(x, i, bits + j, 2))) {
+			i = bits[j + resulta - 1] + 1;
+			j += resulta;
+		}
+		if (j != count) {
+			printf("aui_listbits(..., 2) [%u]: %lu != %lu\n", length, (unsigned long)j, (unsigned long)count);
+			getchar();
+		}
+		free(bits);
+		aui_push(x);
+		length += length / 2 + 1;
+	}
+	aui_wipe();
+	printf("nextbit_prevbit_listbits: finish\n");
+	return;
+}
+
+void popcount_hamming(void)
+{
+	struct aui *x;
+	struct aui *y;
+	unsigned short i;
+	unsigned short j;
+	size_t resulta;
+	size_t resultb;
+
+	printf("popcount_hamming: start\n");
+	/* short short */
+	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(i))))) {
+		printf("aui_pull(...) [short short] == NULL\n");
+		return;
+	}
+	if (!(y = aui_pull(AUI_SIZTOLEN(sizeof(j))))) {
+		printf("aui_pull(...) [short short] == NULL\n");
+		aui_push(x);
+		aui_wipe();
+		return;
+	}
+	i = USHRT_MAX;
+	do {
+		aui_seti(x, i);
+		resulta = aui_popcount(x);
+		resultb = pop(i);
+		if (resulta != resultb) {
+			printf("aui_popcount(%u) [short]: %lu != %lu\n", i, (unsigned long)resulta, (unsigned long)resultb);
+			getchar();
+		}
+		j = USHRT_MAX;
+		do {
+			aui_seti(y, j);
+			resulta = aui_hamming(x, y);
+			resultb = pop(i ^ j);
+			if (resulta != resultb) {
+				printf("aui_hamming(%u, %u) [short short]: %lu != %lu\n", i, j, (unsigned long)resulta, (unsigned long)resultb);
+				getchar();
+			}
+		} while ((j -= 7) > 7);
+		if (!(i % 100))
+			printf("popcount_hamming [short short]: %u\n", i);
+	} while (i--);
+	aui_push(x);
+	aui_push(y);
+	/* large, unequal lengths */
+	if (!(x = aui_pull(1024))) {
+		printf("aui_pull(...) [large] == NULL\n");
+		return;
+	}
+	if (!(y = aui_pull(1000))) {
+		printf("aui_pull(...) [large] == NULL\n");
+		aui_push(x);
+		aui_wipe();
+		return;
+	}
+	aui_seti(x, 0);
+	aui_one(x);
+	aui_seti(y, 0);
+	resultb = 1024 * AUI_TYPE_BIT;
+	do {
+		resulta = aui_popcount(x);
+		if (resulta != resultb) {
+			printf("aui_popcount(...) [large]: %lu != %lu\n", (unsigned long)resulta, (unsigned long)resultb);
+			getchar();
+		}
+		resulta = aui_hamming(x, y);
+		if (resulta != resultb) {
+			printf("aui_hamming(..., 0) [large]: %lu != %lu\n", (unsigned long)resulta, (unsigned long)resultb);
+			getchar();
+		}
+		resulta = aui_hamming(y, x);
+		if (resulta != resultb) {
+			printf("aui_hamming(0, ...) [large]: %lu != %lu\n", (unsigned long)resulta, (unsigned long)resultb);
+			getchar();
+		}
+		aui_shr(x, 1);
+	} while (resultb--);
+	aui_push(x);
+	aui_push(y);
+	aui_wipe();
+	printf("popcount_hamming: finish\n");
+	return;
+}
+
+void hash(void)
+{
+	struct aui *x;
+	struct aui *y;
+	struct aui piece;
+	struct aui zeros;
+	struct aui_hash_state state;
+	AUI_TYPE zero[3];
+	unsigned long random;
+	unsigned long seed;
+	unsigned long expected;
+	unsigned long result;
+	size_t length;
+	size_t start;
+	size_t size;
+	size_t i;
+
+	printf("hash: start\n");
+	random = 1;
+	zero[0] = 0;
+	zero[1] = 0;
+	zero[2] = 0;
+	zeros.array = zero;
+	zeros.next = NULL;
+	zeros.view = 0;
+	/* lengths across several stripes and blocks of the hash */
+	length = 1;
+	while (length < 3000) {
+		if (!(x = aui_pull(length)) || !(y = aui_pull(length + length % 5 + 1))) {
+			printf("aui_pull(...) == NULL\n");
+			return;
+		}
+		i = 0;
+		while (i < length * AUI_TYPE_BIT) {
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(x, i, 8, random >> 8);
+			i += 8;
+		}
+		/* a run of zero limbs, and zero limbs on top */
+		random = random * 1103515245UL + 12345UL;
+		start = (random >> 8) % length;
+		i = start;
+		while ((i < length) && (i < (start + 300))) {
+			x->array[i] = 0;
+			i++;
+		}
+		random = random * 1103515245UL + 12345UL;
+		aui_shr(x, random % (length * AUI_TYPE_BIT / 2 + 1));
+		seed = random >> 4;
+		/* equal values hash equally, whatever their lengths */
+		aui_asgn(y, x);
+		expected = aui_hash(x, seed);
+		if ((result = aui_hash(y, seed)) != expected) {
+			printf("aui_hash(...) [%lu]: %lx != %lx\n", (unsigned long)length, result, expected);
+			getchar();
+		}
+		/* in pieces, with zero limbs on top */
+		aui_hash_init(&state, seed);
+		start = 0;
+		while (start < length) {
+			random = random * 1103515245UL + 12345UL;
+			size = (random >> 8) % 200;
+			size = (size < (length - start)) ? size : (length - start);
+			piece.array = x->array + start;
+			piece.length = size;
+			piece.next = NULL;
+			piece.view = 0;
+			aui_hash_update(&state, &piece);
+			start += size;
+		}
+		zeros.length = 3;
+		aui_hash_update(&state, &zeros);
+		if ((result = aui_hash_final(&state)) != expected) {
+			printf("aui_hash_update(...) [%lu]: %lx != %lx\n", (unsigned long)length, result, expected);
+			getchar();
+		}
+		/* a flipped bit or another seed changes the hash */
+		random = random * 1103515245UL + 12345UL;
+		aui_flipbit(y, (random >> 8) % (y->length * AUI_TYPE_BIT));
+		if (aui_hash(y, seed) == expected) {
+			printf("aui_hash(...) [%lu]: flipped bit\n", (unsigned long)length);
+			getchar();
+		}
+		if (aui_hash(x, seed + 1) == expected) {
+			printf("aui_hash(...) [%lu]: seed\n", (unsigned long)length);
+			getchar();
+		}
+		aui_push(y);
+		aui_push(x);
+		length += length / 8 + 1;
+	}
+	aui_wipe();
+	printf("hash: finish\n");
+	return;
+}
+
+void testbit_setbit_clrbit_flipbit_getbits_setbits(void)
+{
+	struct aui *x;
+	struct aui *y;
+	unsigned long i;
+	unsigned long j;
+	unsigned int k;
+	unsigned long l;
+	unsigned long bits;
+	unsigned long resulta;
+	unsigned long resultb;
+
+	printf("testbit_setbit_clrbit_flipbit_getbits_setbits: start\n");
+	bits = sizeof(l) * CHAR_BIT;
+	/* long */
+	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(l))))) {
+		printf("aui_pull(...) [long] == NULL\n");
+		return;
+	}
+	l = ULONG_MAX;
+	do {
+		i = 0;
+		while (i < bits + AUI_TYPE_BIT) {
+			aui_seti(x, l);
+			resulta = aui_testbit(x, i);
+			resultb = (i < bits) ? ((l >> i) & 1) : 0;
+			if (resulta != resultb) {
+				printf("aui_testbit(%lu, %lu) [long]: %lu != %lu\n", l, i, resulta, resultb);
+				getchar();
+			}
+			aui_setbit(x, i);
+			resulta = aui_geti(x);
+			resultb = (i < bits) ? (l | (1UL << i)) : l;
+			if (resulta != resultb) {
+				printf("aui_setbit(%lu, %lu) [long]: %lu != %lu\n", l, i, resulta, resultb);
+				getchar();
+			}
+			aui_clrbit(x, i);
+			resulta = aui_geti(x);
+			resultb = (i < bits) ? (l & ~(1UL << i)) : l;
+			if (resulta != resultb) {
+				printf("aui_clrbit(%lu, %lu) [long]: %lu != %lu\n", l, i, resulta, resultb);
+				getchar();
+			}
+			aui_flipbit(x, i);
+			aui_flipbit(x, i);
+			aui_flipbit(x, i);
+			resulta = aui_geti(x);
+			resultb = (i < bits) ? (l | (1UL << i)) : l;
+			if (resulta != resultb) {
+				printf("aui_flipbit(%lu, %lu) [long]: %lu != %lu\n", l, i, resulta, resultb);
+				getchar();
+			}
+			k = 0;
+			while (k <= bits) {
+				aui_seti(x, l);
+				resulta = aui_getbits(x, i, k);
+				resultb = (i < bits) ? (l >> i) : 0;
+				if (k < bits)
+					resultb &= (1UL << k) - 1;
+				if (resulta != resultb) {
+					printf("aui_getbits(%lu, %lu, %u) [long]: %lu != %lu\n", l, i, k, resulta, resultb);
+					getchar();
+				}
+				j = ~l;
+				aui_setbits(x, i, k, j);
+				resulta = aui_geti(x);
+				resultb = l;
+				if (i < bits) {
+					resultb = (k < bits) ? ((1UL << k) - 1) << i : ULONG_MAX << i;
+					resultb = (l & ~resultb) | ((j << i) & resultb);
+				}
+				if (resulta != resultb) {
+					printf("aui_setbits(%lu, %lu, %u, %lu) [long]: %lu != %lu\n", l, i, k, j, resulta, resultb);
+					getchar();
+				}
+				k++;
+			}
+			i++;
+		}
+	} while ((l /= 3));
+	aui_push(x);
+	/* large */
+	if (!(x = aui_pull(1024))) {
+		printf("aui_pull(...) [large] == NULL\n");
+		return;
+	}
+	if (!(y = aui_pull(1024))) {
+		printf("aui_pull(...) [large] == NULL\n");
+		aui_push(x);
+		aui_wipe();
+		return;
+	}
+	aui_seti(x, 0);
+	i = 0;
+	while (i < 1024 * AUI_TYPE_BIT) {
+		aui_setbit(x, i);
+		i += 3;
+	}
+	i = 0;
+	while (i < 1024 * AUI_TYPE_BIT) {
+		aui_asgn(y, x);
+		aui_shr(y, i);
+		resulta = aui_getbits(x, i, bits);
+		resultb = aui_geti(y);
+		if (resulta != resultb) {
+			printf("aui_getbits(..., %lu, %lu) [large]: %lu != %lu\n", i, bits, resulta, resultb);
+			getchar();
+		}
+		resulta = aui_testbit(x, i);
+		resultb = !(i % 3);
+		if (resulta != resultb) {
+			printf("aui_testbit(..., %lu) [large]: %lu != %lu\n", i, resulta, resultb);
+			getchar();
+		}
+		i += 7;
+	}
+	aui_push(x);
+	aui_push(y);
+	aui_wipe();
+	printf("testbit_setbit_clrbit_flipbit_getbits_setbits: finish\n");
+	return;
+}
+
+void rank_select(void)
+{
+	struct aui *x;
+	struct aui_index *index;
+	unsigned int length;
+	size_t i;
+	size_t k;
+	size_t resulta;
+	size_t resultb;
+
+	printf("rank_select: start\n");
+	length = 1;
+	while (length < 300) {
+		if (!(x = aui_pull(length))) {
+			printf("aui_pull(%u) == NULL\n", length);
+			return;
+		}
+		aui_seti(x, 0);
+		i = 0;
+		while (i < length * AUI_TYPE_BIT) {
+			if ((i * i + length) % 11 < 3)
+				aui_setbit(x, i);
+			i++;
+		}
+		if (!(index = aui_index_alloc(x))) {
+			printf("aui_index_alloc(...) [%u] == NULL\n", length);
+			aui_push(x);
+			aui_wipe();
+			return;
+		}
+		i = 0;
+		k = 0;
+		while (i <= length * AUI_TYPE_BIT) {
+			resulta = aui_rank(index, i);
+			if (resulta != k) {
+				printf("aui_rank(..., %lu) [%u]: %lu != %lu\n", (unsigned long)i, length, (unsigned long)resulta, (unsigned long)k);
+				getchar();
+			}
+			if (aui_testbit(x, i)) {
+				resulta = aui_select(index, k);
+				if (resulta != i) {
+					printf("aui_select(..., %lu) [%u]: %lu != %lu\n", (unsigned long)k, length, (unsigned long)resulta, (unsigned long)i);
+					getchar();
+				}
+				k++;
+			}
+			i++;
+		}
+		resulta = aui_select(index, k);
+		resultb = AUI_NONE;
+		if (resulta != resultb) {
+			printf("aui_select(..., %lu) [%u]: %lu != %lu\n", (unsigned long)k, length, (unsigned long)resulta, (unsigned long)resultb);
+			getchar();
+		}
+		aui_index_free(index);
+		aui_push(x);
+		length += length / 2 + 1;
+	}
+	aui_wipe();
+	printf("rank_select: finish\n");
+	return;
+}
+
 void one_two_and_ior_xor(void)
 {
+	size_t sizes[] = {31, 32, 33, 63, 64, 65, 95, 100, 129, 200};
 	struct aui *x;
 	struct aui *y;
+	struct aui *z;
+	unsigned long random;
+	size_t n;
+	size_t bit;
+	int op;
+	int a;
+	int b;
 	unsigned char i;
 	unsigned char j;
 	unsigned char resultc;
@@ -628,7 +1347,6 @@ void one_two_and_ior_xor(void)
 	unsigned short results;
 
 	printf("one_two_and_ior_xor: start\n");
-	aui_init();
 	/* char char */
 	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(i))))) {
 		printf("aui_pull(...) [char char] == NULL\n");
@@ -841,6 +1559,53 @@ void one_two_and_ior_xor(void)
 	} while (k--);
 	aui_push(x);
 	aui_push(y);
+	/* integers across the 32 and 64-byte vector blocks and their tails; y is as long as x or a limb shorter */
+	random = 1;
+	n = 0;
+	while (n < 2 * sizeof(sizes) / sizeof(*sizes)) {
+		x = aui_pull(AUI_SIZTOLEN(sizes[n / 2]));
+		y = aui_pull(AUI_SIZTOLEN(sizes[n / 2]) - n % 2);
+		z = aui_pull(AUI_SIZTOLEN(sizes[n / 2]));
+		if (!x || !y || !z) {
+			printf("aui_pull(...) == NULL\n");
+			return;
+		}
+		op = 0;
+		while (op < 4) {
+			bit = 0;
+			while (bit < z->length * AUI_TYPE_BIT) {
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(z, bit, 8, random >> 8);
+				if (bit < y->length * AUI_TYPE_BIT)
+					aui_setbits(y, bit, 8, random >> 16);
+				bit += 8;
+			}
+			aui_asgn(x, z);
+			if (op == 0)
+				aui_one(x);
+			else if (op == 1)
+				aui_and(x, y);
+			else if (op == 2)
+				aui_ior(x, y);
+			else
+				aui_xor(x, y);
+			bit = 0;
+			while (bit < x->length * AUI_TYPE_BIT) {
+				a = aui_testbit(z, bit);
+				b = aui_testbit(y, bit);
+				if (aui_testbit(x, bit) != ((op == 0) ? !a : (op == 1) ? (a & b) : (op == 2) ? (a | b) : (a ^ b))) {
+					printf("aui_one/and/ior/xor(...) [%d, %lu]: bit %lu\n", op, (unsigned long)sizes[n / 2], (unsigned long)bit);
+					getchar();
+				}
+				bit++;
+			}
+			op++;
+		}
+		aui_push(z);
+		aui_push(y);
+		aui_push(x);
+		n++;
+	}
 	aui_wipe();
 	printf("one_two_and_ior_xor: finish\n");
 	return;
@@ -848,13 +1613,23 @@ void one_two_and_ior_xor(void)
 
 void shl_shr_inc_dec(void)
 {
+	size_t sizes[] = {72, 100, 136, 200, 264, 333};
+	size_t shifts[] = {1, 7, AUI_TYPE_BIT - 1, AUI_TYPE_BIT + 3, 3 * AUI_TYPE_BIT + 5, 8 * 64 + 1};
 	struct aui *x;
+	struct aui *y;
+	unsigned long random;
+	size_t n;
+	size_t m;
+	size_t shift;
+	size_t bit;
 	unsigned char i;
 	unsigned short j;
 	unsigned int result;
+	unsigned long k;
+	unsigned long l;
+	unsigned long resultk;
 
 	printf("shl_shr_inc_dec: start\n");
-	aui_init();
 	/* char */
 	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(i))))) {
 		printf("aui_pull(1) == NULL\n");
@@ -939,11 +1714,152 @@ void shl_shr_inc_dec(void)
 			printf("shl_shr_inc_dec: %u\n", j);
 	} while (j--);
 	aui_push(x);
+	/* long, shifting across several elements */
+	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(k))))) {
+		printf("aui_pull(1) == NULL\n");
+		return;
+	}
+	k = ULONG_MAX;
+	do {
+		aui_seti(x, k);
+		l = CHAR_BIT * sizeof(k);
+		while (l--) {
+			aui_seti(x, k);
+			aui_shl(x, l);
+			resultk = aui_geti(x);
+			if (resultk != (k << l)) {
+				printf("aui_shl(%lu, %lu): %lu != %lu\n", k, l, resultk, (k << l));
+				getchar();
+			}
+			aui_seti(x, k);
+			aui_shr(x, l);
+			resultk = aui_geti(x);
+			if (resultk != (k >> l)) {
+				printf("aui_shr(%lu, %lu): %lu != %lu\n", k, l, resultk, (k >> l));
+				getchar();
+			}
+		}
+	} while ((k /= 3));
+	aui_push(x);
+	/* integers of 72 bytes and more, across the vector blocks and the limbs before and after them */
+	random = 1;
+	n = 0;
+	while (n < sizeof(sizes) / sizeof(*sizes)) {
+		if (!(x = aui_pull(AUI_SIZTOLEN(sizes[n]))) || !(y = aui_pull(AUI_SIZTOLEN(sizes[n])))) {
+			printf("aui_pull(...) == NULL\n");
+			return;
+		}
+		m = 0;
+		while (m <= sizeof(shifts) / sizeof(*shifts)) {
+			/* the last shift leaves only the highest bit */
+			shift = (m < sizeof(shifts) / sizeof(*shifts)) ? shifts[m] : x->length * AUI_TYPE_BIT - 1;
+			bit = 0;
+			while (bit < x->length * AUI_TYPE_BIT) {
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(y, bit, 8, random >> 8);
+				bit += 8;
+			}
+			aui_asgn(x, y);
+			aui_shl(x, shift);
+			bit = 0;
+			while (bit < x->length * AUI_TYPE_BIT) {
+				if (aui_testbit(x, bit) != ((bit >= shift) && aui_testbit(y, bit - shift))) {
+					printf("aui_shl(...) [%lu, %lu]: bit %lu\n", (unsigned long)sizes[n], (unsigned long)shift, (unsigned long)bit);
+					getchar();
+				}
+				bit++;
+			}
+			aui_asgn(x, y);
+			aui_shr(x, shift);
+			bit = 0;
+			while (bit < x->length * AUI_TYPE_BIT) {
+				if (aui_testbit(x, bit) != aui_testbit(y, bit + shift)) {
+					printf("aui_shr(...) [%lu, %lu]: bit %lu\n", (unsigned long)sizes[n], (unsigned long)shift, (unsigned long)bit);
+					getchar();
+				}
+				bit++;
+			}
+			m++;
+		}
+		aui_push(y);
+		aui_push(x);
+		n++;
+	}
 	aui_wipe();
 	printf("shl_shr_inc_dec: finish\n");
 	return;
 }
 
+/* w = w + y, or w - y if subtract, one bit at a time */
+void ripple(struct aui *w, const struct aui *y, int subtract)
+{
+	size_t i;
+	int a;
+	int b;
+	int carry;
+
+	carry = subtract;
+	i = 0;
+	while (i < AUI_TYPE_BIT * w->length) {
+		a = aui_testbit(w, i);
+		b = aui_testbit(y, i) ^ subtract;
+		if (a ^ b ^ carry)
+			aui_setbit(w, i);
+		else
+			aui_clrbit(w, i);
+		carry = (a & b) | (carry & (a ^ b));
+		i++;
+	}
+	return;
+}
+
+/* w = x op y one bit at a time, for op as below, using t, both long enough for the full result */
+void serial(struct aui *w, struct aui *t, const struct aui *x, const struct aui *y, int op)
+{
+	size_t i;
+	int a;
+	int b;
+
+	aui_seti(w, 0);
+	aui_seti(t, 0);
+	if (op < 2) {
+		aui_asgn(w, x);
+		ripple(w, y, op);
+	} else if (op == 2) {
+		aui_asgn(t, x);
+		i = 0;
+		while (i < AUI_TYPE_BIT * y->length) {
+			if (aui_testbit(y, i))
+				ripple(w, t, 0);
+			aui_shl(t, 1);
+			i++;
+		}
+	} else if (op < 5) {
+		i = AUI_TYPE_BIT * x->length;
+		while (i--) {
+			aui_shl(t, 1);
+			if (aui_testbit(x, i))
+				aui_setbit(t, 0);
+			if (aui_gte(t, y)) {
+				ripple(t, y, 1);
+				aui_setbit(w, i);
+			}
+		}
+		if (op == 4)
+			aui_asgn(w, t);
+	} else {
+		i = 0;
+		while (i < AUI_TYPE_BIT * w->length) {
+			a = aui_testbit(x, i);
+			b = aui_testbit(y, i);
+			if ((op == 5) ? (a & b) : (op == 6) ? (a | b) : (a ^ b))
+				aui_setbit(w, i);
+			i++;
+		}
+	}
+	return;
+}
+
 void add_sub_mul_div_mod(void)
 {
 	struct aui *x;
@@ -958,7 +1874,6 @@ void add_sub_mul_div_mod(void)
 	unsigned short results2;
 
 	printf("add_sub_mul_div_mod: start\n");
-	aui_init();
 	/* char char */
 	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(i))))) {
 		printf("aui_pull(...) [char char] == NULL\n");
@@ -1027,7 +1942,6 @@ void add_sub_mul_div_mod(void)
 	aui_push(x);
 	aui_push(y);
 	/* short short */
-	aui_init();
 	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(k))))) {
 		printf("aui_pull(...) [short short] == NULL\n");
 		return;
@@ -1095,7 +2009,6 @@ void add_sub_mul_div_mod(void)
 	aui_push(x);
 	aui_push(y);
 	/* char short */
-	aui_init();
 	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(i))))) {
 		printf("aui_pull(...) [char short] == NULL\n");
 		return;
@@ -1163,7 +2076,6 @@ void add_sub_mul_div_mod(void)
 	aui_push(x);
 	aui_push(y);
 	/* short char */
-	aui_init();
 	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(k))))) {
 		printf("aui_pull(...) [short char] == NULL\n");
 		return;
@@ -1235,15 +2147,746 @@ void add_sub_mul_div_mod(void)
 	return;
 }
 
+void add_sub_mul_limbs(void)
+{
+	size_t lengths[] = {1, 2, 3, 4, 5, 7, 8, 9, 13};
+	struct aui *x;
+	struct aui *y;
+	struct aui *r;
+	struct aui *w;
+	struct aui *t;
+	struct aui *e;
+	unsigned long random;
+	size_t count;
+	size_t n;
+	size_t m;
+	size_t i;
+	int op;
+
+	printf("add_sub_mul_limbs: start\n");
+	random = 1;
+	/*
+	 * every pair of lengths, so that the carry chains and the unrolled loops
+	 * of the limb kernels run across limbs; op 2 multiplies into a result
+	 * long enough for the whole product, op 3 into the length of x
+	 */
+	count = sizeof(lengths) / sizeof(*lengths);
+	n = 0;
+	while (n < count * count) {
+		op = 0;
+		while (op < 8) {
+			x = aui_pull(lengths[n % count]);
+			y = aui_pull(lengths[n / count]);
+			m = lengths[n % count] + lengths[n / count];
+			w = aui_pull(m);
+			t = aui_pull(m);
+			r = aui_pull((op % 4 == 2) ? m : lengths[n % count]);
+			e = aui_pull((op % 4 == 2) ? m : lengths[n % count]);
+			if (!x || !y || !w || !t || !r || !e) {
+				printf("aui_pull(...) == NULL\n");
+				return;
+			}
+			/* all ones from op 4 on, for the longest carries */
+			i = 0;
+			while (i < x->length * AUI_TYPE_BIT) {
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(x, i, 8, (op & 4) ? 0xff : random >> 8);
+				i += 8;
+			}
+			i = 0;
+			while (i < y->length * AUI_TYPE_BIT) {
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(y, i, 8, (op & 4) ? 0xff : random >> 8);
+				i += 8;
+			}
+			aui_asgn(r, x);
+			if (op % 4 == 0)
+				aui_add(r, y);
+			else if (op % 4 == 1)
+				aui_sub(r, y);
+			else
+				aui_mul(r, y);
+			serial(w, t, x, y, (op % 4 < 2) ? op % 4 : 2);
+			aui_asgn(e, w);
+			if (!aui_eq(r, e)) {
+				printf("aui_...(...) [%d, %lu, %lu]: r != e\n", op, (unsigned long)x->length, (unsigned long)y->length);
+				getchar();
+			}
+			aui_push(e);
+			aui_push(r);
+			aui_push(t);
+			aui_push(w);
+			aui_push(y);
+			aui_push(x);
+			op++;
+		}
+		n++;
+	}
+	aui_wipe();
+	printf("add_sub_mul_limbs: finish\n");
+	return;
+}
+
+void add3_sub3_mul3_div3_mod3_and3_ior3_xor3(void)
+{
+	struct aui *r;
+	struct aui *x;
+	struct aui *y;
+	struct aui *w;
+	struct aui *t;
+	struct aui *e;
+	unsigned long random;
+	size_t lengths;
+	size_t i;
+	int alias;
+	int op;
+
+	printf("add3_sub3_mul3_div3_mod3_and3_ior3_xor3: start\n");
+	if (!(w = aui_pull(12))) {
+		printf("aui_pull(...) == NULL\n");
+		return;
+	}
+	if (!(t = aui_pull(12))) {
+		printf("aui_pull(...) == NULL\n");
+		aui_push(w);
+		return;
+	}
+	random = 1;
+	/* every combination of lengths 1 to 4 for r, x and y */
+	lengths = 0;
+	while (lengths < 64) {
+		alias = 0;
+		while (alias < 4) {
+			op = 0;
+			while (op < 8) {
+				/* alias 1: r is x, 2: r is y, 3: r is x and y */
+				if (!(r = aui_pull(lengths % 4 + 1)) || !(e = aui_pull(lengths % 4 + 1))) {
+					printf("aui_pull(...) == NULL\n");
+					return;
+				}
+				x = (alias & 1) ? r : aui_pull(lengths / 4 % 4 + 1);
+				y = (alias == 2) ? r : (alias == 3) ? x : aui_pull(lengths / 16 + 1);
+				if (!x || !y) {
+					printf("aui_pull(...) == NULL\n");
+					return;
+				}
+				i = 0;
+				while (i < 4 * AUI_TYPE_BIT) {
+					random = random * 1103515245UL + 12345UL;
+					aui_setbits(r, i, 8, random >> 8);
+					random = random * 1103515245UL + 12345UL;
+					aui_setbits(x, i, 8, random >> 8);
+					random = random * 1103515245UL + 12345UL;
+					aui_setbits(y, i, 8, random >> 8);
+					i += 8;
+				}
+				aui_shr(y, random % (4 * AUI_TYPE_BIT));
+				if (!aui_eval(y))
+					aui_seti(y, 3);
+				serial(w, t, x, y, op);
+				if (op == 0)
+					aui_add3(r, x, y);
+				else if (op == 1)
+					aui_sub3(r, x, y);
+				else if (op == 2)
+					aui_mul3(r, x, y);
+				else if (op == 3)
+					aui_div3(r, x, y);
+				else if (op == 4)
+					aui_mod3(r, x, y);
+				else if (op == 5)
+					aui_and3(r, x, y);
+				else if (op == 6)
+					aui_ior3(r, x, y);
+				else
+					aui_xor3(r, x, y);
+				aui_asgn(e, w);
+				if (!aui_eq(r, e)) {
+					printf("aui_...3(...) [%d, %d, %lu]: r != e\n", op, alias, (unsigned long)lengths);
+					getchar();
+				}
+				if ((y != r) && (y != x))
+					aui_push(y);
+				if (x != r)
+					aui_push(x);
+				aui_push(e);
+				aui_push(r);
+				op++;
+			}
+			alias++;
+		}
+		lengths++;
+	}
+	aui_push(t);
+	aui_push(w);
+	aui_wipe();
+	printf("add3_sub3_mul3_div3_mod3_and3_ior3_xor3: finish\n");
+	return;
+}
+
+void addmul_submul_addshl_subshl(void)
+{
+	struct aui *x;
+	struct aui *y;
+	struct aui *z;
+	struct aui *w;
+	struct aui *e;
+	unsigned long random;
+	size_t lengths;
+	size_t shift;
+	size_t i;
+	int alias;
+	int op;
+
+	printf("addmul_submul_addshl_subshl: start\n");
+	random = 1;
+	/* every combination of lengths 1 to 4 for x, y and z */
+	lengths = 0;
+	while (lengths < 64) {
+		alias = 0;
+		while (alias < 4) {
+			op = 0;
+			while (op < 4) {
+				/* alias 1: y is x, 2: z is x, 3: y and z are x */
+				if (!(x = aui_pull(lengths % 4 + 1)) || !(w = aui_pull(lengths % 4 + 1)) || !(e = aui_pull(lengths % 4 + 1))) {
+					printf("aui_pull(...) == NULL\n");
+					return;
+				}
+				y = (alias & 1) ? x : aui_pull(lengths / 4 % 4 + 1);
+				z = (alias & 2) ? x : aui_pull(lengths / 16 + 1);
+				if (!y || !z) {
+					printf("aui_pull(...) == NULL\n");
+					return;
+				}
+				i = 0;
+				while (i < 4 * AUI_TYPE_BIT) {
+					random = random * 1103515245UL + 12345UL;
+					aui_setbits(x, i, 8, random >> 8);
+					random = random * 1103515245UL + 12345UL;
+					aui_setbits(y, i, 8, random >> 8);
+					random = random * 1103515245UL + 12345UL;
+					aui_setbits(z, i, 8, random >> 8);
+					i += 8;
+				}
+				shift = random % (5 * AUI_TYPE_BIT);
+				aui_asgn(e, x);
+				if (op == 0) {
+					aui_mul3(w, y, z);
+					aui_add(e, w);
+					aui_addmul(x, y, z);
+				} else if (op == 1) {
+					aui_mul3(w, y, z);
+					aui_sub(e, w);
+					aui_submul(x, y, z);
+				} else if (op == 2) {
+					aui_asgn(w, y);
+					aui_shl(w, shift);
+					aui_add(e, w);
+					aui_addshl(x, y, shift);
+				} else {
+					aui_asgn(w, y);
+					aui_shl(w, shift);
+					aui_sub(e, w);
+					aui_subshl(x, y, shift);
+				}
+				if (!aui_eq(x, e)) {
+					printf("aui_...(...) [%d, %d, %lu]: x != e\n", op, alias, (unsigned long)lengths);
+					getchar();
+				}
+				if (z != x)
+					aui_push(z);
+				if (y != x)
+					aui_push(y);
+				aui_push(e);
+				aui_push(w);
+				aui_push(x);
+				op++;
+			}
+			alias++;
+		}
+		lengths++;
+	}
+	aui_wipe();
+	printf("addmul_submul_addshl_subshl: finish\n");
+	return;
+}
+
+void addc_subc_shlc(void)
+{
+	struct aui *x;
+	struct aui *y;
+	struct aui *e;
+	struct aui low;
+	unsigned long random;
+	size_t length;
+	size_t shift;
+	size_t i;
+	AUI_TYPE carry;
+	AUI_TYPE out;
+	int op;
+
+	printf("addc_subc_shlc: start\n");
+	random = 1;
+	/* e is one limb wider than x and holds the carry (or borrow, or shifted out word); y may have a leading zero limb */
+	length = 1;
+	while (length < 5) {
+		op = 0;
+		while (op < 3 * 64) {
+			if (!(x = aui_pull(length)) || !(y = aui_pull(length + !!(op & 16))) || !(e = aui_pull(length + 1))) {
+				printf("aui_pull(...) == NULL\n");
+				return;
+			}
+			aui_seti(y, 0);
+			i = 0;
+			while (i < length * AUI_TYPE_BIT) {
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(x, i, 8, (op & 4) ? 0xff : random >> 8);
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(y, i, 8, (op & 8) ? 0xff : random >> 8);
+				i += 8;
+			}
+			random = random * 1103515245UL + 12345UL;
+			carry = (random >> 8) & 1;
+			shift = (random >> 9) % AUI_TYPE_BIT;
+			aui_asgn(e, x);
+			if (op % 3 == 0) {
+				aui_add(e, y);
+				if (carry)
+					aui_inc(e);
+				out = aui_addc(x, y, carry);
+			} else if (op % 3 == 1) {
+				aui_setbit(e, length * AUI_TYPE_BIT);
+				aui_sub(e, y);
+				if (carry)
+					aui_dec(e);
+				e->array[length] = !e->array[length];
+				out = aui_subc(x, y, carry);
+			} else {
+				aui_shl(e, shift);
+				carry = (AUI_TYPE)(random >> 16);
+				e->array[0] |= carry;
+				out = aui_shlc(x, shift, carry);
+			}
+			low.array = e->array;
+			low.length = length;
+			low.next = NULL;
+			low.view = 0;
+			if (!aui_eq(x, &low) || (out != e->array[length])) {
+				printf("aui_...c(...) [%d, %lu]: x != e\n", op % 3, (unsigned long)length);
+				getchar();
+			}
+			aui_push(e);
+			aui_push(y);
+			aui_push(x);
+			op++;
+		}
+		/* an integer of two blocks shifted a block at a time, low block x, high block y */
+		shift = 0;
+		while (shift < AUI_TYPE_BIT) {
+			if (!(x = aui_pull(length)) || !(y = aui_pull(length)) || !(e = aui_pull(2 * length + 1))) {
+				printf("aui_pull(...) == NULL\n");
+				return;
+			}
+			aui_seti(e, 0);
+			i = 0;
+			while (i < 2 * length * AUI_TYPE_BIT) {
+				random = random * 1103515245UL + 12345UL;
+				aui_setbits(e, i, 8, random >> 8);
+				i += 8;
+			}
+			memcpy(x->array, e->array, sizeof(*x->array) * length);
+			memcpy(y->array, e->array + length, sizeof(*y->array) * length);
+			carry = aui_shlc(x, shift, 0);
+			out = aui_shlc(y, shift, carry);
+			aui_shl(e, shift);
+			low.array = e->array;
+			low.length = length;
+			low.next = NULL;
+			low.view = 0;
+			if (!aui_eq(x, &low)) {
+				printf("aui_shlc(...) [%lu, %lu]: x != e\n", (unsigned long)shift, (unsigned long)length);
+				getchar();
+			}
+			low.array = e->array + length;
+			if (!aui_eq(y, &low) || (out != e->array[2 * length])) {
+				printf("aui_shlc(...) [%lu, %lu]: y != e\n", (unsigned long)shift, (unsigned long)length);
+				getchar();
+			}
+			aui_push(e);
+			aui_push(y);
+			aui_push(x);
+			shift++;
+		}
+		length++;
+	}
+	aui_wipe();
+	printf("addc_subc_shlc: finish\n");
+	return;
+}
+
+void mul_threads(void)
+{
+	struct aui *x;
+	struct aui *y;
+	struct aui *z;
+	size_t length[3];
+	size_t i;
+	unsigned long random;
+	unsigned int j;
+	unsigned int k;
+
+	printf("mul_threads: start\n");
+	length[0] = AUI_SIZTOLEN(4096) * 2;
+	length[1] = AUI_SIZTOLEN(4096) * 3;
+	length[2] = AUI_SIZTOLEN(4096);
+	random = 1;
+	k = 0;
+	while (k < 3) {
+		if (!(x = aui_pull(length[k]))) {
+			printf("aui_pull(...) == NULL\n");
+			return;
+		}
+		if (!(y = aui_pull(length[2 - k]))) {
+			printf("aui_pull(...) == NULL\n");
+			aui_push(x);
+			aui_wipe();
+			return;
+		}
+		if (!(z = aui_pull(length[k]))) {
+			printf("aui_pull(...) == NULL\n");
+			aui_push(x);
+			aui_push(y);
+			aui_wipe();
+			return;
+		}
+		i = 0;
+		while (i < length[k] * AUI_TYPE_BIT) {
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(x, i, 16, random >> 8);
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(y, i, 16, random >> 8);
+			i += 16;
+		}
+		if (k == 1)
+			aui_shr(y, 1000);
+		j = 2;
+		while (j < 7) {
+			aui_threads(1);
+			aui_asgn(z, x);
+			aui_mul(z, y);
+			aui_threads(j);
+			aui_mul(x, y);
+			if (aui_neq(x, z)) {
+				printf("aui_mul(...) [%u, %u threads]: x != z\n", k, j);
+				getchar();
+			}
+			aui_asgn(x, z);
+			j++;
+		}
+		aui_push(x);
+		aui_push(y);
+		aui_push(z);
+		k++;
+	}
+	aui_threads(1);
+	aui_wipe();
+	printf("mul_threads: finish\n");
+	return;
+}
+
+void add_sub_mul_batch(void)
+{
+	struct aui *x[64];
+	struct aui *y[64];
+	struct aui *z[64];
+	struct aui xs[64];
+	struct aui ys[64];
+	size_t i;
+	size_t length;
+	int op;
+
+	printf("add_sub_mul_batch: start\n");
+	i = 0;
+	while (i < 64) {
+		length = i % 7 + 1;
+		if (!(x[i] = aui_pull(length)) || !(y[i] = aui_pull(length + i % 3)) || !(z[i] = aui_pull(length))) {
+			printf("aui_pull(...) [%lu] == NULL\n", (unsigned long)i);
+			return;
+		}
+		i++;
+	}
+	op = 0;
+	while (op < 3) {
+		i = 0;
+		while (i < 64) {
+			aui_seti(x[i], 0);
+			aui_one(x[i]);
+			aui_shr(x[i], i);
+			aui_seti(y[i], 2654435761UL * (i + 1));
+			aui_shl(y[i], i * 3);
+			aui_ior(y[i], x[i]);
+			aui_asgn(z[i], x[i]);
+			if (op == 0)
+				aui_add(z[i], y[i]);
+			else if (op == 1)
+				aui_sub(z[i], y[i]);
+			else
+				aui_mul(z[i], y[i]);
+			xs[i] = *x[i];
+			ys[i] = *y[i];
+			i++;
+		}
+		if (op == 0)
+			aui_add_batch(xs, ys, 64);
+		else if (op == 1)
+			aui_sub_batch(xs, ys, 64);
+		else
+			aui_mul_batch(xs, ys, 64);
+		i = 0;
+		while (i < 64) {
+			if (xs[i].array != x[i]->array) {
+				printf("aui_..._batch(...) [%d, %lu]: array moved\n", op, (unsigned long)i);
+				getchar();
+			}
+			if (!aui_eq(&xs[i], z[i])) {
+				printf("aui_..._batch(...) [%d, %lu]: x != z\n", op, (unsigned long)i);
+				getchar();
+			}
+			i++;
+		}
+		op++;
+	}
+	i = 0;
+	while (i < 64) {
+		aui_push(x[i]);
+		aui_push(y[i]);
+		aui_push(z[i]);
+		i++;
+	}
+	aui_wipe();
+	printf("add_sub_mul_batch: finish\n");
+	return;
+}
+
+void vector(void)
+{
+	struct aui_vector *x;
+	struct aui_vector *y;
+	struct aui_vector *z;
+	struct aui *a;
+	struct aui *b;
+	unsigned char *result;
+	unsigned char *expected;
+	size_t count;
+	size_t i;
+	int op;
+
+	printf("vector: start\n");
+	count = 1000;
+	if (!(x = aui_vector_alloc(5, count)) || !(y = aui_vector_alloc(5, count)) || !(z = aui_vector_alloc(5, count))) {
+		printf("aui_vector_alloc(...) == NULL\n");
+		return;
+	}
+	if (!(result = malloc(count)) || !(expected = malloc(count))) {
+		printf("malloc(...) == NULL\n");
+		return;
+	}
+	if (!(a = aui_pull(5)) || !(b = aui_pull(5))) {
+		printf("aui_pull(...) == NULL\n");
+		return;
+	}
+	op = 0;
+	while (op < 7) {
+		i = 0;
+		while (i < count) {
+			aui_seti(a, 0);
+			aui_one(a);
+			aui_shr(a, i % (5 * AUI_TYPE_BIT + 1));
+			aui_seti(b, 2654435761UL * (i + 1));
+			aui_shl(b, i % 97);
+			if (i % 5 == 1)
+				aui_asgn(b, a);
+			if (i % 5 == 2)
+				aui_xor(b, a);
+			aui_vector_set(x, i, a);
+			aui_vector_set(y, i, b);
+			expected[i] = (op == 5) ? aui_eq(a, b) : aui_lt(a, b);
+			if (op == 0)
+				aui_add(a, b);
+			else if (op == 1)
+				aui_sub(a, b);
+			else if (op == 2)
+				aui_and(a, b);
+			else if (op == 3)
+				aui_ior(a, b);
+			else if (op == 4)
+				aui_xor(a, b);
+			aui_vector_set(z, i, a);
+			i++;
+		}
+		if (op == 0)
+			aui_vector_add(x, y);
+		else if (op == 1)
+			aui_vector_sub(x, y);
+		else if (op == 2)
+			aui_vector_and(x, y);
+		else if (op == 3)
+			aui_vector_ior(x, y);
+		else if (op == 4)
+			aui_vector_xor(x, y);
+		else if (op == 5)
+			aui_vector_eq(result, x, y);
+		else
+			aui_vector_lt(result, x, y);
+		i = 0;
+		while (i < count) {
+			if (op < 5) {
+				aui_vector_get(a, x, i);
+				aui_vector_get(b, z, i);
+				if (!aui_eq(a, b)) {
+					printf("aui_vector_...(...) [%d, %lu]: x != z\n", op, (unsigned long)i);
+					getchar();
+				}
+			} else if (result[i] != expected[i]) {
+				printf("aui_vector_...(...) [%d, %lu]: %u != %u\n", op, (unsigned long)i, result[i], expected[i]);
+				getchar();
+			}
+			i++;
+		}
+		op++;
+	}
+	aui_push(a);
+	aui_push(b);
+	aui_wipe();
+	free(result);
+	free(expected);
+	aui_vector_free(x);
+	aui_vector_free(y);
+	aui_vector_free(z);
+	printf("vector: finish\n");
+	return;
+}
+
+/* compares aui<bits>_op() with aui_op(), for op 0 to 6: add, sub, mul, shl, shr, seti, set */
+#define FIXED_TEST(bits) \
+	{ \
+	struct aui##bits p; \
+	struct aui##bits q; \
+	struct aui##bits r; \
+\
+	if (!(a = aui_pull(AUI_SIZTOLEN((bits) / CHAR_BIT))) || !(b = aui_pull(AUI_SIZTOLEN((bits) / CHAR_BIT))) \
+		|| !(c = aui_pull(AUI_SIZTOLEN((bits) / CHAR_BIT)))) { \
+		printf("aui_pull(...) [%d] == NULL\n", bits); \
+		return; \
+	} \
+	i = 0; \
+	while (i < 1000) { \
+		j = 0; \
+		while (j < a->length * AUI_TYPE_BIT) { \
+			random = random * 1103515245UL + 12345UL; \
+			aui_setbits(a, j, 16, random >> 8); \
+			random = random * 1103515245UL + 12345UL; \
+			aui_setbits(b, j, 16, random >> 8); \
+			j += 16; \
+		} \
+		if (i % 4 == 1) \
+			aui_shr(b, i % (bits)); \
+		if (i % 4 == 2) \
+			aui_asgn(b, a); \
+		if (i % 4 == 3) \
+			aui_shr(a, i % (bits)); \
+		shift = i % ((bits) + 2); \
+		aui##bits##_set(&p, a); \
+		aui##bits##_set(&q, b); \
+		if ((aui##bits##_eq(&p, &q) != aui_eq(a, b)) || (aui##bits##_lt(&p, &q) != aui_lt(a, b)) \
+			|| (aui##bits##_lt(&q, &p) != aui_lt(b, a))) { \
+			printf("aui%d_eq(...) or aui%d_lt(...) [%lu]\n", bits, bits, (unsigned long)i); \
+			getchar(); \
+		} \
+		op = 0; \
+		while (op < 7) { \
+			r = p; \
+			aui_asgn(c, a); \
+			if (op == 0) { \
+				aui##bits##_add(&r, &q); \
+				aui_add(c, b); \
+			} else if (op == 1) { \
+				aui##bits##_sub(&r, &q); \
+				aui_sub(c, b); \
+			} else if (op == 2) { \
+				aui##bits##_mul(&r, &q); \
+				aui_mul(c, b); \
+			} else if (op == 3) { \
+				aui##bits##_shl(&r, shift); \
+				aui_shl(c, shift); \
+			} else if (op == 4) { \
+				aui##bits##_shr(&r, shift); \
+				aui_shr(c, shift); \
+			} else if (op == 5) { \
+				aui##bits##_seti(&r, random); \
+				aui_seti(c, random); \
+				if (aui##bits##_geti(&r) != aui_geti(c)) { \
+					printf("aui%d_geti(...) [%lu]\n", bits, (unsigned long)i); \
+					getchar(); \
+				} \
+			} else { \
+				aui##bits##_add(&r, &r); \
+				aui_add(c, c); \
+			} \
+			aui##bits##_get(b, &r); \
+			if (aui_neq(b, c)) { \
+				printf("aui%d_...(...) [%d, %lu]\n", bits, op, (unsigned long)i); \
+				getchar(); \
+			} \
+			aui##bits##_get(b, &q); \
+			op++; \
+		} \
+		i++; \
+	} \
+	aui_push(a); \
+	aui_push(b); \
+	aui_push(c); \
+	}
+
+void fixed(void)
+{
+	struct aui *a;
+	struct aui *b;
+	struct aui *c;
+	unsigned long random;
+	size_t shift;
+	size_t i;
+	size_t j;
+	int op;
+
+	printf("fixed: start\n");
+	random = 1;
+	FIXED_TEST(128)
+	FIXED_TEST(256)
+	FIXED_TEST(512)
+	FIXED_TEST(1024)
+	aui_wipe();
+	printf("fixed: finish\n");
+	return;
+}
+
 void sets_gets(void)
 {
 	#define BASE85 85
 	#define STRMAX 100
+	#define LARGE 8192
 	struct aui *x;
+	struct aui *y;
 	unsigned char i;
 	unsigned short j;
 	unsigned long result;
+	unsigned long random;
+	unsigned int base[3] = {2, 10, BASE85};
+	size_t count;
+	size_t k;
+	size_t l;
 	char string[STRMAX];
+	char *large;
 	char set[BASE85] = {
 		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
 		'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J',
@@ -1257,7 +2900,6 @@ void sets_gets(void)
 	};
 
 	printf("sets_gets: start\n");
-	aui_init();
 	/* char */
 	if (!(x = aui_pull(AUI_SIZTOLEN(sizeof(i))))) {
 		printf("aui_pull(...) [char] == NULL\n");
@@ -1318,23 +2960,225 @@ void sets_gets(void)
 			printf("sets_gets [short]: %u\n", j);
 	} while (j--);
 	aui_push(x);
+	/* large, both through the divide-and-conquer conversion and threads */
+	if (!(large = malloc(LARGE * CHAR_BIT + 2))) {
+		printf("malloc(...) [large] == NULL\n");
+		aui_wipe();
+		return;
+	}
+	if (!(x = aui_pull(AUI_SIZTOLEN(LARGE)))) {
+		printf("aui_pull(...) [large] == NULL\n");
+		free(large);
+		aui_wipe();
+		return;
+	}
+	if (!(y = aui_pull(AUI_SIZTOLEN(LARGE)))) {
+		printf("aui_pull(...) [large] == NULL\n");
+		aui_push(x);
+		free(large);
+		aui_wipe();
+		return;
+	}
+	k = 0;
+	while (k < 3) {
+		/* base^count is a one followed by count zeros, base^count - 1 count maximal digits */
+		aui_seti(x, 1);
+		aui_seti(y, base[k]);
+		count = 0;
+		while (aui_msba(x) < (LARGE / 8 - 1) * CHAR_BIT) {
+			aui_mul(x, y);
+			count++;
+		}
+		if (aui_gets(large, count + 1, set, base[k], x)) {
+			printf("aui_gets(...) [large] == TRUE\n");
+			getchar();
+		}
+		if (!aui_gets(large, count + 2, set, base[k], x)) {
+			printf("aui_gets(...) [large] == FALSE\n");
+			getchar();
+		}
+		l = 1;
+		while ((l <= count) && (large[l] == set[0]))
+			l++;
+		if ((large[0] != '1') || (l <= count) || large[l]) {
+			printf("aui_gets(...) [large]: %u^%lu\n", base[k], (unsigned long)count);
+			getchar();
+		}
+		if (!aui_sets(y, large, set, base[k]) || aui_neq(x, y)) {
+			printf("aui_sets(...) [large]: %u^%lu\n", base[k], (unsigned long)count);
+			getchar();
+		}
+		aui_dec(x);
+		if (!aui_gets(large, count + 1, set, base[k], x)) {
+			printf("aui_gets(...) [large] == FALSE\n");
+			getchar();
+		}
+		l = 0;
+		while ((l < count) && (large[l] == set[base[k] - 1]))
+			l++;
+		if ((l < count) || large[l]) {
+			printf("aui_gets(...) [large]: %u^%lu - 1\n", base[k], (unsigned long)count);
+			getchar();
+		}
+		if (!aui_sets(y, large, set, base[k]) || aui_neq(x, y)) {
+			printf("aui_sets(...) [large]: %u^%lu - 1\n", base[k], (unsigned long)count);
+			getchar();
+		}
+		k++;
+	}
+	random = 1;
+	l = 0;
+	while (l < x->length * AUI_TYPE_BIT) {
+		random = random * 1103515245UL + 12345UL;
+		aui_setbits(x, l, 16, random >> 8);
+		l += 16;
+	}
+	k = 1;
+	while (k <= 4) {
+		aui_threads(k);
+		aui_seti(y, 0);
+		if (!aui_gets(large, LARGE * CHAR_BIT + 2, set, 10, x)
+			|| !aui_sets(y, large, set, 10) || aui_neq(x, y)) {
+			printf("aui_gets(...) or aui_sets(...) [large]: %lu threads\n", (unsigned long)k);
+			getchar();
+		}
+		k *= 4;
+	}
+	aui_threads(1);
+	aui_push(y);
+	aui_push(x);
+	free(large);
 	aui_wipe();
 	printf("sets_gets: finish\n");
 	return;
 }
 
+void import_export(void)
+{
+	struct aui *x;
+	struct aui *y;
+	struct aui *e;
+	unsigned char data[80];
+	unsigned char back[81];
+	size_t sizes[] = {1, 2, 3, 4, 8, 16};
+	unsigned long random;
+	unsigned long probe;
+	size_t count;
+	size_t size;
+	size_t total;
+	size_t words;
+	size_t bits;
+	size_t b;
+	size_t i;
+	int order;
+	int endian;
+	int native;
+
+	printf("import_export: start\n");
+	random = 1;
+	probe = 1;
+	native = *(unsigned char *)&probe ? AUI_LITTLE : AUI_BIG;
+	if (!(e = aui_pull(AUI_SIZTOLEN(sizeof(data))))) {
+		printf("aui_pull(...) == NULL\n");
+		return;
+	}
+	i = 0;
+	while (i < 20000) {
+		random = random * 1103515245UL + 12345UL;
+		size = sizes[(random >> 8) % (sizeof(sizes) / sizeof(*sizes))];
+		count = (random >> 12) % (sizeof(data) / size + 1);
+		order = ((random >> 20) & 1) ? AUI_BIG : AUI_LITTLE;
+		endian = (int)((random >> 21) % 3) - 1;
+		total = count * size;
+		if (!(x = aui_pull((random >> 24) % AUI_SIZTOLEN(sizeof(data)) + 1)) || !(y = aui_pull(x->length))) {
+			printf("aui_pull(...) == NULL\n");
+			return;
+		}
+		/* random bytes, some of the most significant cleared */
+		b = 0;
+		while (b < total) {
+			random = random * 1103515245UL + 12345UL;
+			data[b] = (unsigned char)(random >> 16);
+			b++;
+		}
+		/* e is the value of data, byte by byte */
+		aui_seti(e, 0);
+		b = 0;
+		while (b < total) {
+			words = (order == AUI_BIG) ? (count - 1 - b / size) : (b / size);
+			bits = (((endian ? endian : native) == AUI_BIG) ? (size - 1 - b % size) : (b % size));
+			if (((random >> 8) % 4) && ((total - b) < ((random >> 10) % 8)))
+				data[words * size + bits] = 0;
+			aui_setbits(e, b * CHAR_BIT, CHAR_BIT, data[words * size + bits]);
+			b++;
+		}
+		aui_import(x, data, count, size, order, endian);
+		aui_asgn(y, e);
+		if (!aui_eq(x, y)) {
+			printf("aui_import(...) [%lu, %lu, %d, %d]: x != e\n", (unsigned long)count, (unsigned long)size, order, endian);
+			getchar();
+		}
+		/* the words needed, and the bytes back as they were */
+		back[total] = 0xA5;
+		words = aui_export(back, count, size, order, endian, e);
+		bits = aui_msba(e);
+		if ((bits == AUI_NONE) ? words : ((words * size * CHAR_BIT <= bits) || ((words - 1) * size * CHAR_BIT > bits))) {
+			printf("aui_export(...) [%lu, %lu, %d, %d] == %lu\n", (unsigned long)count, (unsigned long)size, order, endian, (unsigned long)words);
+			getchar();
+		}
+		b = 0;
+		while ((b < total) && (back[b] == data[b]))
+			b++;
+		if ((b < total) || (back[total] != 0xA5)) {
+			printf("aui_export(...) [%lu, %lu, %d, %d]: back != data\n", (unsigned long)count, (unsigned long)size, order, endian);
+			getchar();
+		}
+		/* a shorter x exports zero-padded, and imports back */
+		aui_export(back, count, size, order, endian, x);
+		aui_seti(y, 1);
+		aui_import(y, back, count, size, order, endian);
+		if (!aui_eq(x, y)) {
+			printf("aui_export(...) [%lu, %lu, %d, %d]: x != y\n", (unsigned long)count, (unsigned long)size, order, endian);
+			getchar();
+		}
+		aui_push(y);
+		aui_push(x);
+		i++;
+	}
+	aui_push(e);
+	aui_wipe();
+	printf("import_export: finish\n");
+	return;
+}
+
 int main(void)
 {
-	init_msbn_lsbn();
+	msbn_lsbn();
 	alloc_free();
 	pull_push_wipe();
+	view();
 	seti_geti();
 	asgn_swap();
 	eq_neq_lt_lte_gt_gte_eval();
+	cmp_sort();
 	msba_lsba();
+	nextbit_prevbit_listbits();
+	popcount_hamming();
+	hash();
+	testbit_setbit_clrbit_flipbit_getbits_setbits();
+	rank_select();
 	one_two_and_ior_xor();
 	shl_shr_inc_dec();
 	add_sub_mul_div_mod();
+	add_sub_mul_limbs();
+	add3_sub3_mul3_div3_mod3_and3_ior3_xor3();
+	addmul_submul_addshl_subshl();
+	addc_subc_shlc();
+	mul_threads();
+	add_sub_mul_batch();
+	vector();
+	fixed();
 	sets_gets();
+	import_export();
 	return 0;
 }
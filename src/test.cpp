@@ -0,0 +1,562 @@
+/*
+ * test.cpp
+ * 2026-10-19
+ *
+ * Arbitrary unsigned integer library, C++ interface
+ * Copyright (c) 2018 Johan Palm <johan@pij.se>
+ * Published under the MIT license.
+ */
+
+#include "aui.hpp"
+#include <cstdio>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+void integer(void)
+{
+	struct aui *a;
+	struct aui *b;
+	struct aui *p;
+	unsigned long random;
+	std::size_t i;
+	std::size_t j;
+	int op;
+
+	std::printf("integer: start\n");
+	/* moves steal the pointer, destruction pushes it back on the list */
+	{
+		auipp::integer x(4, 1234);
+		auipp::integer y(4);
+
+		p = x.get();
+		y = std::move(x);
+		if ((y.get() != p) || (y.geti() != 1234)) {
+			std::printf("auipp::integer: move assignment\n");
+			std::getchar();
+		}
+		auipp::integer z(std::move(y));
+		if ((z.get() != p) || y.get()) {
+			std::printf("auipp::integer: move construction\n");
+			std::getchar();
+		}
+	}
+	a = aui_pull(4);
+	b = aui_pull(4);
+	if (((a != p) && (b != p)) || (a == b)) {
+		std::printf("auipp::integer: destruction\n");
+		std::getchar();
+	}
+	aui_push(a);
+	aui_push(b);
+	/* an integer over a view writes through to the buffer, and leaves it on destruction */
+	{
+		AUI_TYPE buffer[4] = {0, 0, 0, 0};
+		struct aui a = {buffer, 4, nullptr, 0};
+
+		{
+			auipp::integer v(aui_view(buffer, 4));
+
+			v = 1234;
+			v += v;
+		}
+		if (aui_geti(&a) != 2468) {
+			std::printf("auipp::integer: view\n");
+			std::getchar();
+		}
+		/* also when an expression on the right refers to it */
+		{
+			auipp::integer v(aui_view(buffer, 4));
+			auipp::integer y(4, 100);
+
+			v = 10;
+			v = y * y - (v << 1);
+			if ((v.get()->array != buffer) || (aui_geti(&a) != 9980)) {
+				std::printf("auipp::integer: view expression\n");
+				std::getchar();
+			}
+		}
+		/* and when an rvalue is moved into it */
+		{
+			auipp::integer v(aui_view(buffer, 4));
+			auipp::integer y(4, 100);
+			auipp::integer w(4, 300);
+
+			v = y.copy() + y;
+			if ((v.get()->array != buffer) || (aui_geti(&a) != 200)) {
+				std::printf("auipp::integer: view move\n");
+				std::getchar();
+			}
+			v = std::move(w);
+			if ((v.get()->array != buffer) || (aui_geti(&a) != 300)) {
+				std::printf("auipp::integer: view move\n");
+				std::getchar();
+			}
+		}
+	}
+	/* std::hash ignores leading zero limbs, like operator== */
+	{
+		std::unordered_set<auipp::integer> set;
+
+		set.emplace(4, 1234);
+		set.emplace(8, 1234);
+		set.emplace(2, 5678);
+		if ((set.size() != 2) || !set.count(auipp::integer(16, 5678)) || set.count(auipp::integer(4, 1235))) {
+			std::printf("std::hash<auipp::integer>\n");
+			std::getchar();
+		}
+	}
+	/* copies are explicit and independent */
+	{
+		auipp::integer x(4, 1234);
+		auipp::integer y(x.copy());
+		auipp::integer z(8, 5678);
+
+		++y;
+		if ((x.geti() != 1234) || (y.geti() != 1235) || (x.get() == y.get())) {
+			std::printf("auipp::integer::copy()\n");
+			std::getchar();
+		}
+		z.assign(x);
+		if ((z.length() != 8) || (z != x)) {
+			std::printf("auipp::integer::assign()\n");
+			std::getchar();
+		}
+		if ((z.gets() != "1234") || (z.gets("01", 2) != "10011010010")) {
+			std::printf("auipp::integer::gets()\n");
+			std::getchar();
+		}
+		z.sets("ff", "0123456789abcdef", 16);
+		if (z.geti() != 255) {
+			std::printf("auipp::integer::sets()\n");
+			std::getchar();
+		}
+		try {
+			x /= auipp::integer(4);
+			std::printf("auipp::integer: division by zero\n");
+			std::getchar();
+		} catch (const std::domain_error &) {
+		}
+	}
+	/* the operators against the functions */
+	if (!(a = aui_pull(5))) {
+		std::printf("aui_pull(...) == NULL\n");
+		return;
+	}
+	random = 1;
+	i = 0;
+	while (i < 1000) {
+		auipp::integer x(5);
+		auipp::integer y(5);
+
+		j = 0;
+		while (j < 5 * AUI_TYPE_BIT) {
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(x.get(), j, 8, random >> 8);
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(y.get(), j, 8, random >> 8);
+			j += 8;
+		}
+		aui_shr(y.get(), i % (5 * AUI_TYPE_BIT));
+		if (((x == y) != !!aui_eq(x.get(), y.get())) || ((x < y) != !!aui_lt(x.get(), y.get()))
+			|| ((x >= y) != !!aui_gte(x.get(), y.get())) || (!x != !aui_eval(x.get()))) {
+			std::printf("auipp::integer: comparison [%lu]\n", (unsigned long)i);
+			std::getchar();
+		}
+		op = 0;
+		while (op < 12) {
+			auipp::integer z(x.copy());
+
+			aui_asgn(a, x.get());
+			if (op == 0) {
+				z = std::move(z) + y;
+				aui_add(a, y.get());
+			} else if (op == 1) {
+				z = std::move(z) - y;
+				aui_sub(a, y.get());
+			} else if (op == 2) {
+				z = std::move(z) * y;
+				aui_mul(a, y.get());
+			} else if (op == 3) {
+				if (!y)
+					y = 1;
+				z = std::move(z) / y;
+				aui_div(a, y.get());
+			} else if (op == 4) {
+				if (!y)
+					y = 1;
+				z = std::move(z) % y;
+				aui_mod(a, y.get());
+			} else if (op == 5) {
+				z = std::move(z) & y;
+				aui_and(a, y.get());
+			} else if (op == 6) {
+				z = std::move(z) | y;
+				aui_ior(a, y.get());
+			} else if (op == 7) {
+				z = std::move(z) ^ y;
+				aui_xor(a, y.get());
+			} else if (op == 8) {
+				z = std::move(z) << (i % 50);
+				aui_shl(a, i % 50);
+			} else if (op == 9) {
+				z = std::move(z) >> (i % 50);
+				aui_shr(a, i % 50);
+			} else if (op == 10) {
+				++z;
+				aui_inc(a);
+			} else {
+				--z;
+				aui_dec(a);
+			}
+			if (!aui_eq(z.get(), a)) {
+				std::printf("auipp::integer: operator [%d, %lu]\n", op, (unsigned long)i);
+				std::getchar();
+			}
+			op++;
+		}
+		i++;
+	}
+	aui_push(a);
+	aui_wipe();
+	std::printf("integer: finish\n");
+	return;
+}
+
+void expression(void)
+{
+	struct aui *a;
+	struct aui *t;
+	unsigned long random;
+	std::size_t i;
+	std::size_t j;
+	int op;
+
+	std::printf("expression: start\n");
+	if (!(a = aui_pull(5))) {
+		std::printf("aui_pull(...) == NULL\n");
+		return;
+	}
+	if (!(t = aui_pull(5))) {
+		std::printf("aui_pull(...) == NULL\n");
+		aui_push(a);
+		return;
+	}
+	{
+		auipp::integer x(4, 1000);
+		auipp::integer y(4, 256);
+		auipp::integer r(1);
+
+		r = x >> 8;
+		if (r.geti() != 3) {
+			std::printf("auipp::integer: expression >> [1000 >> 8]\n");
+			std::getchar();
+		}
+		r = (x + y) / y;
+		if (r.geti() != 4) {
+			std::printf("auipp::integer: expression / [1256 / 256]\n");
+			std::getchar();
+		}
+	}
+	random = 1;
+	i = 0;
+	while (i < 1000) {
+		auipp::integer w(5);
+		auipp::integer x(5);
+		auipp::integer y(5);
+		auipp::integer z(5);
+
+		j = 0;
+		while (j < 5 * AUI_TYPE_BIT) {
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(w.get(), j, 8, random >> 8);
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(x.get(), j, 8, random >> 8);
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(y.get(), j, 8, random >> 8);
+			j += 8;
+		}
+		aui_shr(y.get(), i % (5 * AUI_TYPE_BIT));
+		if (!y)
+			y = 1;
+		op = 0;
+		while (op < 13) {
+			auipp::integer r(5, 1);
+
+			aui_seti(a, 1);
+			if (op == 0) {
+				/* regrouped, one temporary for x * y */
+				r = w * w + x * y - w;
+				aui_asgn(a, w.get());
+				aui_mul(a, w.get());
+				aui_asgn(t, x.get());
+				aui_mul(t, y.get());
+				aui_add(a, t);
+				aui_sub(a, w.get());
+			} else if (op == 1) {
+				/* the destination on both sides */
+				r.assign(x);
+				r = y - r;
+				aui_asgn(a, y.get());
+				aui_sub(a, x.get());
+			} else if (op == 2) {
+				r.assign(w);
+				r = (r ^ x) % (y | x) + (r << (i % 50));
+				aui_asgn(a, w.get());
+				aui_xor(a, x.get());
+				aui_asgn(t, y.get());
+				aui_ior(t, x.get());
+				aui_mod(a, t);
+				aui_asgn(t, w.get());
+				aui_shl(t, i % 50);
+				aui_add(a, t);
+			} else if (op == 3) {
+				r.assign(w);
+				r -= x - (y - r);
+				aui_asgn(a, w.get());
+				aui_sub(a, x.get());
+				aui_add(a, y.get());
+				aui_sub(a, w.get());
+			} else if (op == 4) {
+				r += (w - x) >> (i % 50);
+				r -= y + w;
+				r += x - y;
+				aui_asgn(a, w.get());
+				aui_sub(a, x.get());
+				aui_shr(a, i % 50);
+				aui_inc(a);
+				aui_sub(a, y.get());
+				aui_sub(a, w.get());
+				aui_add(a, x.get());
+				aui_sub(a, y.get());
+			} else if (op == 5) {
+				r *= w * x & y;
+				aui_asgn(a, w.get());
+				aui_mul(a, x.get());
+				aui_and(a, y.get());
+			} else if (op == 6) {
+				r.assign(x);
+				r = w / y - r / (y - (y >> 1));
+				aui_asgn(a, w.get());
+				aui_div(a, y.get());
+				aui_asgn(t, y.get());
+				aui_shr(t, 1);
+				aui_asgn(z.get(), y.get());
+				aui_sub(z.get(), t);
+				aui_asgn(t, x.get());
+				aui_div(t, z.get());
+				aui_sub(a, t);
+			} else if (op == 7) {
+				/* fused, no temporaries */
+				r = w * x + y * y - (x << (i % 50)) + (w << 3) - x * w;
+				aui_asgn(a, w.get());
+				aui_mul(a, x.get());
+				aui_asgn(t, y.get());
+				aui_mul(t, y.get());
+				aui_add(a, t);
+				aui_asgn(t, x.get());
+				aui_shl(t, i % 50);
+				aui_sub(a, t);
+				aui_asgn(t, w.get());
+				aui_shl(t, 3);
+				aui_add(a, t);
+				aui_asgn(t, x.get());
+				aui_mul(t, w.get());
+				aui_sub(a, t);
+			} else if (op == 8) {
+				auipp::integer s(8, x * y + w);
+
+				aui_asgn(a, x.get());
+				aui_mul(a, y.get());
+				aui_add(a, w.get());
+				r.assign(s);
+			} else {
+				/* a destination shorter than the operands */
+				auipp::integer s(2);
+
+				if (op == 9) {
+					s = w >> (i % 50 + AUI_TYPE_BIT);
+					aui_asgn(a, w.get());
+					aui_shr(a, i % 50 + AUI_TYPE_BIT);
+				} else if (op == 10) {
+					s = (w + x) / y;
+					aui_asgn(a, w.get());
+					aui_add(a, x.get());
+					aui_div(a, y.get());
+				} else if (op == 11) {
+					s = (w ^ x) % (y | x) + (w * x >> 5);
+					aui_asgn(a, w.get());
+					aui_xor(a, x.get());
+					aui_asgn(t, y.get());
+					aui_ior(t, x.get());
+					aui_mod(a, t);
+					aui_asgn(t, w.get());
+					aui_mul(t, x.get());
+					aui_shr(t, 5);
+					aui_add(a, t);
+				} else {
+					s.assign(x);
+					s %= y | (w >> 1);
+					aui_asgn(a, x.get());
+					aui_shl(a, 3 * AUI_TYPE_BIT);
+					aui_shr(a, 3 * AUI_TYPE_BIT);
+					aui_asgn(t, w.get());
+					aui_shr(t, 1);
+					aui_ior(t, y.get());
+					aui_mod(a, t);
+				}
+				aui_shl(a, 3 * AUI_TYPE_BIT);
+				aui_shr(a, 3 * AUI_TYPE_BIT);
+				r.assign(s);
+			}
+			if (!aui_eq(r.get(), a)) {
+				std::printf("auipp::integer: expression [%d, %lu]\n", op, (unsigned long)i);
+				std::getchar();
+			}
+			op++;
+		}
+		i++;
+	}
+	aui_push(t);
+	aui_push(a);
+	aui_wipe();
+	std::printf("expression: finish\n");
+	return;
+}
+
+#if __cplusplus >= 201402L
+/* the prime of secp256k1 and constants derived from it at compile time */
+constexpr auipp::fixed<256> prime = auipp::fixed<256>::parse("115792089237316195423570985008687907853269984665640564039457584007908834671663");
+constexpr auipp::fixed<256> mask = (auipp::fixed<256>(1) << 32) - 1;
+static_assert(prime == auipp::fixed<256>(0) - (auipp::fixed<256>(1) << 32) - 977, "auipp::fixed::parse()");
+static_assert((prime & mask).geti() == 0xFFFFFC2FUL, "auipp::fixed: operator&");
+static_assert((prime * 3 == prime + prime + prime) && (mask * mask == (auipp::fixed<256>(1) << 64) - (auipp::fixed<256>(1) << 33) + 1), "auipp::fixed: operator*");
+static_assert((prime >> 224 << 224) + (prime % (auipp::fixed<256>(1) << 224)) == prime, "auipp::fixed: shift");
+static_assert(prime / 1000000007 * 1000000007 + prime % 1000000007 == prime, "auipp::fixed: operator/");
+static_assert(auipp::fixed<256>::parse("deadbeef", "0123456789abcdef", 16).geti() == 0xDEADBEEFUL, "auipp::fixed::parse()");
+
+void fixed(void)
+{
+	struct aui *a;
+	struct aui *b;
+	struct aui *c;
+	unsigned long random;
+	std::size_t i;
+	std::size_t j;
+	int op;
+
+	std::printf("fixed: start\n");
+	if (!(a = aui_pull(AUI_SIZTOLEN(32)))) {
+		std::printf("aui_pull(...) == NULL\n");
+		return;
+	}
+	if (!(b = aui_pull(AUI_SIZTOLEN(32)))) {
+		std::printf("aui_pull(...) == NULL\n");
+		aui_push(a);
+		return;
+	}
+	if (!(c = aui_pull(AUI_SIZTOLEN(32)))) {
+		std::printf("aui_pull(...) == NULL\n");
+		aui_push(b);
+		aui_push(a);
+		return;
+	}
+	if ((prime.gets() != "115792089237316195423570985008687907853269984665640564039457584007908834671663")
+		|| (auipp::fixed<256>(1234).gets("01", 2) != "10011010010")) {
+		std::printf("auipp::fixed::gets()\n");
+		std::getchar();
+	}
+	/* the operators against the functions */
+	random = 1;
+	i = 0;
+	while (i < 1000) {
+		auipp::fixed<256> x;
+		auipp::fixed<256> y;
+
+		j = 0;
+		while (j < 256) {
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(a, j, 8, random >> 8);
+			random = random * 1103515245UL + 12345UL;
+			aui_setbits(b, j, 8, random >> 8);
+			j += 8;
+		}
+		aui_shr(b, i % 256);
+		if (!aui_eval(b))
+			aui_seti(b, 1);
+		x.set(a);
+		y.set(b);
+		if (((x == y) != !!aui_eq(a, b)) || ((x < y) != !!aui_lt(a, b)) || ((x >= y) != !!aui_gte(a, b))) {
+			std::printf("auipp::fixed: comparison [%lu]\n", (unsigned long)i);
+			std::getchar();
+		}
+		op = 0;
+		while (op < 12) {
+			auipp::fixed<256> z(x);
+
+			aui_asgn(c, a);
+			if (op == 0) {
+				z += y;
+				aui_add(c, b);
+			} else if (op == 1) {
+				z -= y;
+				aui_sub(c, b);
+			} else if (op == 2) {
+				z *= y;
+				aui_mul(c, b);
+			} else if (op == 3) {
+				z /= y;
+				aui_div(c, b);
+			} else if (op == 4) {
+				z %= y;
+				aui_mod(c, b);
+			} else if (op == 5) {
+				z &= y;
+				aui_and(c, b);
+			} else if (op == 6) {
+				z |= y;
+				aui_ior(c, b);
+			} else if (op == 7) {
+				z ^= y;
+				aui_xor(c, b);
+			} else if (op == 8) {
+				z <<= i % 300;
+				aui_shl(c, i % 300);
+			} else if (op == 9) {
+				z >>= i % 300;
+				aui_shr(c, i % 300);
+			} else if (op == 10) {
+				++z;
+				aui_inc(c);
+			} else {
+				--z;
+				aui_dec(c);
+			}
+			z.get(a);
+			if (!aui_eq(a, c)) {
+				std::printf("auipp::fixed: operator [%d, %lu]\n", op, (unsigned long)i);
+				std::getchar();
+			}
+			x.get(a);
+			op++;
+		}
+		i++;
+	}
+	aui_push(c);
+	aui_push(b);
+	aui_push(a);
+	aui_wipe();
+	std::printf("fixed: finish\n");
+	return;
+}
+#endif
+
+int main(void)
+{
+	integer();
+	expression();
+#if __cplusplus >= 201402L
+	fixed();
+#endif
+	return 0;
+}